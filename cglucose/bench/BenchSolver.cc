@@ -0,0 +1,140 @@
+/*
+    Microbenchmarks of the core routines of the solver.
+    See BenchSolver.h
+*/
+
+#include <chrono>
+
+#include "bench/BenchSolver.h"
+
+using namespace Glucose;
+
+static inline double elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+//=================================================================================================
+// Fixture:
+
+
+void BenchSolver::buildLearnts(uint64_t nbConflicts)
+{
+    if (!ok || !simplify()) return;
+    while (conflicts < nbConflicts) {
+        lbool ret = search(0);
+        if (ret == l_False) { ok = false; break; }
+        if (ret == l_True) break;
+    }
+    cancelUntil(0);
+}
+
+
+// Random decisions (with random polarities) are used instead of the heuristic so that the trails
+// cover the whole formula.
+void BenchSolver::recordTrails(int nbTrails)
+{
+    if (!ok || !simplify()) return;
+    for (int n = 0; n < nbTrails; n++) {
+        Trail t;
+        t.conflict = false;
+        for (;;) {
+            Var start = irand(random_seed, nVars()), v = start;
+            while (value(v) != l_Undef || !decision[v]) {
+                v = (v + 1) % nVars();
+                if (v == start) break;
+            }
+            if (value(v) != l_Undef || !decision[v]) break;
+
+            Lit p = mkLit(v, drand(random_seed) < 0.5);
+            newDecisionLevel();
+            uncheckedEnqueue(p);
+            t.decisions.push_back(p);
+            if (propagate() != CRef_Undef) { t.conflict = true; break; }
+        }
+        cancelUntil(0);
+        trails.push_back(t);
+    }
+}
+
+
+int BenchSolver::nbConflicts() const
+{
+    int n = 0;
+    for (size_t i = 0; i < trails.size(); i++) n += trails[i].conflict;
+    return n;
+}
+
+
+// Replay the decisions of a trail. The watch lists are reordered by previous replays, so a
+// decision may already be assigned or the conflict may come earlier.
+CRef BenchSolver::replay(const Trail& t, double* time)
+{
+    for (size_t i = 0; i < t.decisions.size(); i++) {
+        if (value(t.decisions[i]) != l_Undef) continue;
+        newDecisionLevel();
+        uncheckedEnqueue(t.decisions[i]);
+        auto start = std::chrono::steady_clock::now();
+        CRef confl = propagate();
+        if (time) *time += elapsed(start);
+        if (confl != CRef_Undef) return confl;
+    }
+    return CRef_Undef;
+}
+
+
+//=================================================================================================
+// Benchmarks:
+
+
+double BenchSolver::benchPropagate(uint64_t& calls)
+{
+    double time = 0;
+    calls = 0;
+    if (!ok) return 0;
+    for (size_t i = 0; i < trails.size(); i++) {
+        replay(trails[i], &time);
+        calls += decisionLevel();
+        cancelUntil(0);
+    }
+    return time;
+}
+
+
+// 'analyze' bumps the activities of the variables and of the clauses and updates the LBDs: it
+// runs on a copy, so every repetition starts from the same snapshot.
+double BenchSolver::benchAnalyze(uint64_t& calls) const
+{
+    double time = 0;
+    calls = 0;
+    if (!ok) return 0;
+    BenchSolver snapshot(*this);
+    vec<Lit> learnt_clause, selectors;
+    int backtrack_level;
+    unsigned int nblevels, szWithoutSelectors;
+    for (size_t i = 0; i < trails.size(); i++) {
+        CRef confl = snapshot.replay(trails[i], NULL);
+        if (confl != CRef_Undef && snapshot.decisionLevel() > 0) {
+            learnt_clause.clear();
+            selectors.clear();
+            auto start = std::chrono::steady_clock::now();
+            snapshot.analyze(confl, learnt_clause, selectors, backtrack_level, nblevels, szWithoutSelectors);
+            time += elapsed(start);
+            calls++;
+        }
+        snapshot.cancelUntil(0);
+    }
+    return time;
+}
+
+
+// The database is reduced on a copy, so every repetition starts from the same snapshot.
+double BenchSolver::benchReduceDB(uint64_t& calls) const
+{
+    BenchSolver snapshot(*this);
+    calls = 1;
+    auto start = std::chrono::steady_clock::now();
+    snapshot.reduceDB();
+    return elapsed(start);
+}
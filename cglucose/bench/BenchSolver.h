@@ -0,0 +1,54 @@
+/*
+    Microbenchmarks of the core routines of the solver on fixtures built from a CNF.
+
+    A fixture is built once per instance: a learnt clause database (a short search without the
+    BDD side) and a set of recorded trails (random decisions until a conflict or a model). Each
+    benchmark then replays its part of the fixture:
+      - propagate : the decisions of every recorded trail, timing each call to 'propagate()';
+      - analyze   : every recorded conflict on a copy of the fixture, timing the call to 'analyze()';
+      - reduceDB  : a copy of the learnt clause database, timing one call to 'reduceDB()'.
+    Parsing is timed separately, on a fresh solver.
+*/
+
+#ifndef Glucose_BenchSolver_h
+#define Glucose_BenchSolver_h
+
+#include "core/Solver.h"
+#include <vector>
+
+namespace Glucose {
+
+//=================================================================================================
+// BenchSolver -- a solver exposing its core routines to the benchmarks:
+
+class BenchSolver : public Solver {
+public:
+    BenchSolver() {}
+    BenchSolver(const BenchSolver& s) : Solver(s), trails(s.trails) {}
+
+    // Fixture:
+    void   buildLearnts (uint64_t nbConflicts);  // Search (without the BDD side) for 'nbConflicts' conflicts.
+    void   recordTrails (int nbTrails);          // Record trails from random decisions at level 0.
+    int    nbLearnts    () const { return learnts.size(); }
+    int    nbTrails     () const { return trails.size(); }
+    int    nbConflicts  () const;
+
+    // Benchmarks, each one returns the time in seconds of the timed calls and the number of calls:
+    double benchPropagate(uint64_t& calls);
+    double benchAnalyze  (uint64_t& calls) const;
+    double benchReduceDB (uint64_t& calls) const;
+
+protected:
+    struct Trail {
+        std::vector<Lit> decisions;
+        bool             conflict;   // The last decision led to a conflict.
+    };
+    std::vector<Trail> trails;
+
+    CRef replay(const Trail& t, double* time);   // Returns the conflict at the end of the trail, if any.
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+    glucose-bench: microbenchmarks of propagate, analyze, reduceDB and parsing.
+
+    Usage: glucose-bench [options] [input-files]
+    Without input files, the instances bundled in simp/ are used (run from the cglucose directory).
+    Every benchmark is repeated and reported with its mean, standard deviation and the half width
+    of the 95% confidence interval of the mean.
+*/
+
+#include <string.h>
+#include <zlib.h>
+#include <chrono>
+#include <functional>
+
+#include "utils/System.h"
+#include "utils/Options.h"
+#include "utils/Statistics.h"
+#include "core/Dimacs.h"
+#include "core/BinaryCnf.h"
+#include "bench/BenchSolver.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Options:
+
+
+static const char* _cat = "BENCH";
+
+static IntOption    opt_reps     (_cat, "reps",      "Number of timed repetitions of each benchmark", 20, IntRange(2, INT32_MAX));
+static IntOption    opt_warmup   (_cat, "warmup",    "Number of untimed repetitions before the timed ones", 2, IntRange(0, INT32_MAX));
+static Int64Option  opt_conflicts(_cat, "conflicts", "Number of conflicts of the search building the learnt clause database", 20000, Int64Range(0, INT64_MAX));
+static IntOption    opt_trails   (_cat, "trails",    "Number of recorded trails", 1000, IntRange(1, INT32_MAX));
+static StringOption opt_only     (_cat, "only",      "Comma separated list of benchmarks to run (parse, propagate, analyze, reduce)", "parse,propagate,analyze,reduce");
+
+
+//=================================================================================================
+// Runner:
+
+
+static bool selected(const char* name)
+{
+    const char* list = opt_only;
+    size_t len = strlen(name);
+    for (const char* p = list; (p = strstr(p, name)) != NULL; p += len)
+        if ((p == list || p[-1] == ',') && (p[len] == ',' || p[len] == '\0'))
+            return true;
+    return false;
+}
+
+
+// Run a benchmark 'warmup + reps' times. The benchmark returns the time of its timed section and
+// the number of calls it timed.
+static void run(const char* name, const char* instance, std::function<double(uint64_t&)> bench)
+{
+    if (!selected(name)) return;
+    uint64_t calls = 0;
+    for (int i = 0; i < opt_warmup; i++) bench(calls);
+
+    Sample times;
+    for (int i = 0; i < opt_reps; i++) times.push(bench(calls));
+
+    if (calls == 0) {
+        printf("%-10s %-24s skipped (nothing to time)\n", name, instance);
+        return;
+    }
+    printf("%-10s %-24s %5d %12.3f %10.3f %10.3f %10" PRIu64" %12.1f\n", name, instance, times.size(),
+           times.mean() * 1e3, times.stddev() * 1e3, times.ci95() * 1e3, calls, times.mean() * 1e9 / calls);
+}
+
+
+static double parse(const char* file, uint64_t& calls)
+{
+    auto start = std::chrono::steady_clock::now();
+    Solver S;
+    parse_CNF(file, S);
+    calls = 1;
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+//=================================================================================================
+// Main:
+
+
+int main(int argc, char** argv)
+{
+    setUsageHelp("USAGE: %s [options] <input-file> ...\n\n  where input may be plain, gzipped, xz, zstd or bzip2 compressed DIMACS.\n");
+    parseOptions(argc, argv, true);
+
+    const char* bundled[] = { "simp/sgen.cnf", "simp/fuhs-aprove-16.cnf" };
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) files.push_back(argv[i]);
+    if (files.empty()) files.assign(bundled, bundled + 2);
+
+    printf("c %-8s %-24s %5s %12s %10s %10s %10s %12s\n", "", "instance", "reps", "mean (ms)", "stddev", "95% CI", "calls", "ns/call");
+    for (size_t f = 0; f < files.size(); f++) {
+        const char* file = files[f];
+        const char* instance = strrchr(file, '/') ? strrchr(file, '/') + 1 : file;
+
+        InputStream* in = InputStream::open(file);
+        if (in == NULL) {
+            printf("c ERROR! Could not open file: %s\n", file);
+            continue;
+        }
+        BenchSolver S;
+        S.verbosity = 0;
+        parse_DIMACS(*in, S);
+        delete in;
+
+        S.buildLearnts(opt_conflicts);
+        S.recordTrails(opt_trails);
+        printf("c %s: %d vars, %d clauses, %d learnts, %d trails (%d conflicts)\n",
+               instance, S.nVars(), S.nClauses(), S.nbLearnts(), S.nbTrails(), S.nbConflicts());
+
+        run("parse",     instance, [file](uint64_t& calls) { return parse(file, calls); });
+        run("propagate", instance, [&S](uint64_t& calls) { return S.benchPropagate(calls); });
+        run("analyze",   instance, [&S](uint64_t& calls) { return S.benchAnalyze(calls); });
+        run("reduce",    instance, [&S](uint64_t& calls) { return S.benchReduceDB(calls); });
+    }
+    return 0;
+}
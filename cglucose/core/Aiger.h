@@ -0,0 +1,220 @@
+/*
+    AIGER circuits (and-inverter graphs with latches), in the ASCII ("aag") and binary ("aig")
+    formats of AIGER 1.9: inputs, latches with their reset values, outputs, bad state properties,
+    invariant constraints and and-gates. Justice and fairness properties are read and ignored.
+
+    A literal is 2 * variable + negation; variable 0 is the constant false. The gates are put in
+    topological order (the binary format guarantees it, the ASCII one does not), so that a gate
+    comes after the gates it reads. The file may be compressed (see InputStream).
+
+    The circuit is not turned into a CNF here: see Bmc, which encodes it frame by frame.
+*/
+
+#ifndef Glucose_Aiger_h
+#define Glucose_Aiger_h
+
+#include <stdio.h>
+#include <memory>
+
+#include "mtl/IntTypes.h"
+#include "mtl/Vec.h"
+#include "utils/ParseUtils.h"
+#include "utils/InputStream.h"
+
+namespace Glucose {
+
+struct AigerLatch { unsigned lit, next, reset; };     // 'reset' is 0, 1 or 'lit' (uninitialized).
+struct AigerAnd   { unsigned lhs, rhs0, rhs1; };
+
+//=================================================================================================
+// Aiger -- a sequential circuit:
+
+class Aiger {
+public:
+    unsigned         maxVar;
+    vec<unsigned>    inputs;
+    vec<AigerLatch>  latches;
+    vec<unsigned>    outputs;
+    vec<unsigned>    bad;
+    vec<unsigned>    constraints;
+    vec<AigerAnd>    ands;                           // In topological order.
+
+    Aiger() : maxVar(0) {}
+
+    // The bad state properties: those of the file, or its outputs if it has none (AIGER 1.0).
+    const vec<unsigned>& properties() const { return bad.size() > 0 ? bad : outputs; }
+};
+
+//=================================================================================================
+// Parser:
+
+// Reads an unsigned number ending a line or followed by a space ('*in' is left on it).
+template<class B>
+static unsigned aigerNumber(B& in) {
+    if (*in < '0' || *in > '9') parseError(stdout, "Unexpected char in AIGER file: %c\n", *in);
+    uint64_t v = 0;
+    while (*in >= '0' && *in <= '9') {
+        v = v * 10 + (*in - '0'), ++in;
+        if (v > UINT32_MAX) parseError(stdout, "Number too large in AIGER file\n"); }
+    return (unsigned)v; }
+
+template<class B>
+static void aigerSpace(B& in) {
+    if (*in != ' ') parseError(stdout, "Expected a space in AIGER file\n");
+    ++in; }
+
+template<class B>
+static void aigerNewline(B& in) {
+    if (*in != '\n') parseError(stdout, "Expected a new line in AIGER file\n");
+    ++in; }
+
+// Reads a line of 'n' numbers into 'out'.
+template<class B>
+static void aigerLine(B& in, unsigned* out, int n) {
+    for (int i = 0; i < n; i++) {
+        if (i > 0) aigerSpace(in);
+        out[i] = aigerNumber(in); }
+    aigerNewline(in); }
+
+// Reads a 7 bits per byte number of the binary format.
+template<class B>
+static unsigned aigerDelta(B& in) {
+    uint64_t v = 0;
+    for (int shift = 0;; shift += 7) {
+        if (*in == EOF || shift > 28) parseError(stdout, "Truncated or corrupt AIGER file\n");
+        unsigned char b = (unsigned char)*in; ++in;
+        v |= (uint64_t)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) break; }
+    if (v > UINT32_MAX) parseError(stdout, "Corrupt AIGER file\n");
+    return (unsigned)v; }
+
+// Puts the gates in topological order and checks that every literal read is defined. Exits on a
+// cycle or an undefined literal.
+inline void aigerSortAnds(Aiger& aig) {
+    vec<int>  gate (aig.maxVar + 1, -1);      // Index of the gate defining a variable.
+    vec<char> state(aig.maxVar + 1, 0);       // 0: not visited, 1: in progress, 2: done.
+    state[0] = 2;
+    for (int i = 0; i < aig.inputs .size(); i++) state[aig.inputs [i] >> 1] = 2;
+    for (int i = 0; i < aig.latches.size(); i++) state[aig.latches[i].lit >> 1] = 2;
+    for (int i = 0; i < aig.ands   .size(); i++) gate [aig.ands[i].lhs >> 1] = i;
+
+    vec<AigerAnd> sorted;
+    vec<unsigned> stack;
+    for (int i = 0; i < aig.ands.size(); i++) {
+        stack.push(aig.ands[i].lhs >> 1);
+        while (stack.size() > 0) {
+            unsigned v = stack.last();
+            if (state[v] == 2) { stack.pop(); continue; }
+            if (gate[v] < 0) parseError(stdout, "Undefined literal %u in AIGER file\n", 2 * v);
+            const AigerAnd& g = aig.ands[gate[v]];
+            if (state[v] == 0) {
+                state[v] = 1;
+                if (state[g.rhs0 >> 1] == 1 || state[g.rhs1 >> 1] == 1)
+                    parseError(stdout, "Cyclic and-gates in AIGER file\n");
+                if (state[g.rhs0 >> 1] == 0) stack.push(g.rhs0 >> 1);
+                if (state[g.rhs1 >> 1] == 0) stack.push(g.rhs1 >> 1);
+            } else {
+                state[v] = 2;
+                sorted.push(g);
+                stack.pop(); }
+        }
+    }
+    sorted.moveTo(aig.ands);
+
+    vec<unsigned> used;
+    for (int i = 0; i < aig.latches    .size(); i++) used.push(aig.latches[i].next);
+    for (int i = 0; i < aig.outputs    .size(); i++) used.push(aig.outputs[i]);
+    for (int i = 0; i < aig.bad        .size(); i++) used.push(aig.bad[i]);
+    for (int i = 0; i < aig.constraints.size(); i++) used.push(aig.constraints[i]);
+    for (int i = 0; i < used.size(); i++)
+        if (state[used[i] >> 1] != 2) parseError(stdout, "Undefined literal %u in AIGER file\n", used[i]);
+}
+
+template<class B>
+static void parse_Aiger_main(B& in, Aiger& aig) {
+    bool binary;
+    if      (eagerMatch(in, "aag")) binary = false;     // A mismatch leaves 'in' after the 'a' of "aig".
+    else if (*in == 'i' && eagerMatch(in, "ig")) binary = true;
+    else parseError(stdout, "Not an AIGER file\n");
+
+    // Header: M I L O A, then optionally B C J F.
+    unsigned h[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    int      n    = 0;
+    while (n < 9 && *in == ' ') { ++in; h[n++] = aigerNumber(in); }
+    if (n < 5) parseError(stdout, "Incomplete AIGER header\n");
+    aigerNewline(in);
+    unsigned M = h[0], I = h[1], L = h[2], O = h[3], A = h[4], Bn = h[5], C = h[6], J = h[7], F = h[8];
+    if ((uint64_t)I + L + A > M) parseError(stdout, "AIGER header: M < I + L + A\n");
+    aig.maxVar = M;
+
+    auto checkLit = [&](unsigned lit) {
+        if (lit >> 1 > M) parseError(stdout, "Literal %u out of range in AIGER file\n", lit); };
+
+    unsigned line[3];
+    for (unsigned i = 0; i < I; i++) {
+        if (binary) aig.inputs.push(2 * (i + 1));
+        else {
+            aigerLine(in, line, 1);
+            if (line[0] < 2 || (line[0] & 1)) parseError(stdout, "Invalid input literal in AIGER file\n");
+            checkLit(line[0]);
+            aig.inputs.push(line[0]); }
+    }
+    for (unsigned i = 0; i < L; i++) {
+        AigerLatch l;
+        if (binary) l.lit = 2 * (I + i + 1);
+        else {
+            l.lit = aigerNumber(in);
+            aigerSpace(in); }
+        l.next  = aigerNumber(in);
+        l.reset = 0;
+        if (*in == ' ') { ++in; l.reset = aigerNumber(in); }
+        aigerNewline(in);
+        if (l.lit < 2 || (l.lit & 1)) parseError(stdout, "Invalid latch literal in AIGER file\n");
+        if (l.reset != 0 && l.reset != 1 && l.reset != l.lit) parseError(stdout, "Invalid latch reset in AIGER file\n");
+        checkLit(l.lit), checkLit(l.next);
+        aig.latches.push(l);
+    }
+    for (unsigned i = 0; i < O;  i++) { aigerLine(in, line, 1); checkLit(line[0]); aig.outputs    .push(line[0]); }
+    for (unsigned i = 0; i < Bn; i++) { aigerLine(in, line, 1); checkLit(line[0]); aig.bad        .push(line[0]); }
+    for (unsigned i = 0; i < C;  i++) { aigerLine(in, line, 1); checkLit(line[0]); aig.constraints.push(line[0]); }
+    // Justice properties: their sizes, then their literals; fairness constraints: one literal each.
+    vec<unsigned> justice;
+    for (unsigned i = 0; i < J; i++) { aigerLine(in, line, 1); justice.push(line[0]); }
+    for (unsigned i = 0; i < J; i++)
+        for (unsigned j = 0; j < justice[i]; j++) aigerLine(in, line, 1);
+    for (unsigned i = 0; i < F; i++) aigerLine(in, line, 1);
+
+    for (unsigned i = 0; i < A; i++) {
+        AigerAnd g;
+        if (binary) {
+            g.lhs = 2 * (I + L + i + 1);
+            unsigned d0 = aigerDelta(in), d1 = aigerDelta(in);
+            if (d0 == 0 || d0 > g.lhs || d1 > g.lhs - d0) parseError(stdout, "Invalid and-gate in AIGER file\n");
+            g.rhs0 = g.lhs - d0;
+            g.rhs1 = g.rhs0 - d1;
+        } else {
+            aigerLine(in, line, 3);
+            g.lhs = line[0], g.rhs0 = line[1], g.rhs1 = line[2];
+            if (g.lhs < 2 || (g.lhs & 1)) parseError(stdout, "Invalid and-gate in AIGER file\n");
+            checkLit(g.lhs), checkLit(g.rhs0), checkLit(g.rhs1);
+        }
+        aig.ands.push(g);
+    }
+    // The symbol table and the comments that may follow are not needed.
+
+    aigerSortAnds(aig);   // Only checks the binary format, whose gates are in order already.
+}
+
+// Opens 'file' (NULL for the standard input) and reads the circuit. Exits if the file cannot be read
+// or is not a valid AIGER file.
+inline void parse_Aiger(const char* file, Aiger& aig) {
+    std::unique_ptr<InputStream> input(InputStream::open(file));
+    if (input == NULL) parseFail(1);
+    StreamBuffer in(*input);
+    parse_Aiger_main(in, aig);
+}
+
+//=================================================================================================
+}
+
+#endif
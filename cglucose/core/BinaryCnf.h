@@ -0,0 +1,168 @@
+/*
+    Binary CNF files: a DIMACS instance converted once, then loaded without parsing.
+
+    Layout, in the byte order of the machine that wrote it (recorded in the header):
+
+        header   magic "GBCN", version, byte order, number of variables (32 bits each),
+                 number of clauses, number of literals (64 bits each)
+        offsets  (clauses + 1) 64 bits offsets of the clauses in the literal array
+        lits     32 bits literals, as in Lit::x (2 * variable + sign)
+
+    The loader maps the file, checks it, pre-sizes the solver for the whole problem (see
+    Solver::beginBulkLoad) and hands the clauses to addClause_ straight from the mapping. A file from
+    another architecture, truncated or inconsistent is refused rather than misread.
+*/
+
+#ifndef Glucose_BinaryCnf_h
+#define Glucose_BinaryCnf_h
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mtl/IntTypes.h"
+#include "core/SolverTypes.h"
+#include "core/Dimacs.h"
+
+namespace Glucose {
+
+static const uint32_t binaryCnfMagic     = 0x4e434247; // "GBCN"
+static const uint32_t binaryCnfVersion   = 1;
+static const uint32_t binaryCnfByteOrder = 0x01020304;
+
+struct BinaryCnfHeader {
+    uint32_t magic, version, byteOrder, nbVars;
+    uint64_t nbClauses, nbLits;
+};
+
+//=================================================================================================
+// BinaryCnfWriter -- collects a problem through the solver interface the DIMACS parser uses:
+
+class BinaryCnfWriter {
+    int              vars;
+    vec<uint32_t>    lits;
+    vec<uint64_t>    offsets;
+public:
+    BinaryCnfWriter() : vars(0) { offsets.push(0); }
+
+    int  nVars     () const { return vars; }
+    int  nClauses  () const { return offsets.size() - 1; }
+    Var  newVar    (bool = true, bool = true) { return vars++; }
+    void beginBulkLoad(int, uint64_t nb_clauses, uint64_t) { offsets.capacity((int)nb_clauses + 1); }
+    void endBulkLoad  () {}
+    bool addClause_(vec<Lit>& ps) {
+        for (int i = 0; i < ps.size(); i++) lits.push(toInt(ps[i]));
+        offsets.push(lits.size());
+        return true; }
+
+    // Returns false if the file could not be written completely.
+    bool write(const char* file, int declared_vars) const {
+        FILE* out = fopen(file, "wb");
+        if (out == NULL) return false;
+        BinaryCnfHeader h;
+        h.magic     = binaryCnfMagic;
+        h.version   = binaryCnfVersion;
+        h.byteOrder = binaryCnfByteOrder;
+        h.nbVars    = declared_vars > vars ? declared_vars : vars;
+        h.nbClauses = nClauses();
+        h.nbLits    = lits.size();
+        bool ok = fwrite(&h, sizeof(h), 1, out) == 1
+               && fwrite(&offsets[0], sizeof(uint64_t), offsets.size(), out) == (size_t)offsets.size()
+               && (lits.size() == 0 || fwrite(&lits[0], sizeof(uint32_t), lits.size(), out) == (size_t)lits.size());
+        return fclose(out) == 0 && ok; }
+};
+
+// Converts a DIMACS file (any format InputStream reads, NULL for the standard input) into a binary
+// CNF file. Returns false if the output could not be written.
+inline bool convert_BinaryCnf(const char* dimacs, const char* file) {
+    InputStream* in = InputStream::open(dimacs);
+    if (in == NULL) return false;
+    BinaryCnfWriter w;
+    int declared_vars = parse_DIMACS(*in, w);
+    delete in;
+    return w.write(file, declared_vars); }
+
+//=================================================================================================
+// Loading:
+
+inline bool isBinaryCnf(const char* file) {
+    uint32_t magic = 0;
+    FILE* f = file != NULL ? fopen(file, "rb") : NULL;
+    if (f == NULL) return false;
+    bool ok = fread(&magic, sizeof(magic), 1, f) == 1 && magic == binaryCnfMagic;
+    fclose(f);
+    return ok; }
+
+// Inserts the problem of a binary CNF file into the solver. Returns the number of variables, or -1
+// (with a message on stderr) if the file cannot be mapped or is not a valid binary CNF file.
+template<class Solver>
+static int load_BinaryCnf(const char* file, Solver& S) {
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) { fprintf(stderr, "ERROR! Could not open file: %s\n", file); return -1; }
+    struct stat st;
+    void* map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (uint64_t)st.st_size >= sizeof(BinaryCnfHeader))
+        map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { fprintf(stderr, "ERROR! Could not map file: %s\n", file); return -1; }
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+    BinaryCnfHeader        h       = *(const BinaryCnfHeader*)map;
+    const uint64_t*        offsets = (const uint64_t*)((const BinaryCnfHeader*)map + 1);
+    const uint32_t*        lits    = (const uint32_t*)(offsets + h.nbClauses + 1);
+    uint64_t               size    = (uint64_t)st.st_size;
+
+    const char* error = NULL;
+    if      (h.magic != binaryCnfMagic)                        error = "not a binary CNF file";
+    else if (h.byteOrder != binaryCnfByteOrder)                error = "written on a machine of another byte order";
+    else if (h.version != binaryCnfVersion)                    error = "unsupported version";
+    else if (h.nbVars > (uint32_t)INT32_MAX || h.nbClauses > size / sizeof(uint64_t)
+             || h.nbLits > size / sizeof(uint32_t)
+             || size != sizeof(h) + (h.nbClauses + 1) * sizeof(uint64_t) + h.nbLits * sizeof(uint32_t))
+                                                               error = "truncated file";
+    else if (offsets[0] != 0 || offsets[h.nbClauses] != h.nbLits)
+                                                               error = "inconsistent clause offsets";
+    if (error == NULL)
+        for (uint64_t i = 0; i < h.nbLits; i++)
+            if (lits[i] >> 1 >= h.nbVars) { error = "literal out of range"; break; }
+    if (error != NULL) {
+        fprintf(stderr, "ERROR! %s: %s\n", file, error);
+        munmap(map, st.st_size);
+        return -1; }
+
+    S.beginBulkLoad(h.nbVars, h.nbClauses, h.nbLits);
+    while (S.nVars() < (int)h.nbVars) S.newVar();
+
+    vec<Lit> clause;
+    for (uint64_t c = 0; c < h.nbClauses; c++) {
+        uint64_t b = offsets[c], e = offsets[c + 1];
+        if (e < b || e > h.nbLits) {
+            fprintf(stderr, "ERROR! %s: inconsistent clause offsets\n", file);
+            munmap(map, st.st_size);
+            return -1; }
+        // 'addClause_' sorts and shrinks its argument, so the clause is copied out of the mapping.
+        clause.clear();
+        clause.growTo((int)(e - b));
+        memcpy((Lit*)clause, lits + b, (e - b) * sizeof(uint32_t));
+        S.addClause_(clause);
+    }
+    S.endBulkLoad();
+    munmap(map, st.st_size);
+    return h.nbVars; }
+
+// Inserts the problem of 'file' into the solver, be it a binary CNF file or DIMACS (see
+// parse_DIMACS). Exits if the file cannot be read.
+template<class Solver>
+static int parse_CNF(const char* file, Solver& S) {
+    if (!isBinaryCnf(file)) return parse_DIMACS(file, S);
+    int vars = load_BinaryCnf(file, S);
+    if (vars < 0) parseFail(1);
+    return vars; }
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+    Binary checkpoints of the state of a solver (see Solver::writeCheckpoint and
+    Solver::loadCheckpoint).
+
+    A checkpoint is streamed through a buffered file, clause by clause, so writing one does not
+    need a copy of the clause database. It is written to '<file>.tmp' which is then renamed over
+    '<file>': the checkpoint on disk is always a complete one. Values are stored in the byte order
+    of the machine, the header records it so that a checkpoint from another architecture is
+    refused instead of misread.
+*/
+
+#ifndef Glucose_Checkpoint_h
+#define Glucose_Checkpoint_h
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "mtl/IntTypes.h"
+
+namespace Glucose {
+
+static const uint32_t checkpointMagic     = 0x4b504347; // "GCPK"
+static const uint32_t checkpointVersion   = 1;
+static const uint32_t checkpointByteOrder = 0x01020304;
+
+//=================================================================================================
+// CheckpointWriter / CheckpointReader -- raw values on a stream:
+
+class CheckpointWriter {
+    FILE* out;
+    bool  good;
+public:
+    CheckpointWriter(FILE* f) : out(f), good(true) {}
+
+    void bytes (const void* p, size_t n) { if (good && fwrite(p, 1, n, out) != n) good = false; }
+    void put32 (uint32_t v)              { bytes(&v, sizeof(v)); }
+    void put64 (uint64_t v)              { bytes(&v, sizeof(v)); }
+    void putDouble(double v)             { bytes(&v, sizeof(v)); }
+    void putString(const char* s)        { uint32_t n = s ? strlen(s) : 0; put32(n); bytes(s, n); }
+    bool ok() const                      { return good; }
+};
+
+class CheckpointReader {
+    FILE* in;
+    bool  good;
+public:
+    CheckpointReader(FILE* f) : in(f), good(true) {}
+
+    void bytes (void* p, size_t n)       { if (!good || fread(p, 1, n, in) != n) good = false, memset(p, 0, n); }
+    uint32_t get32 ()                    { uint32_t v; bytes(&v, sizeof(v)); return v; }
+    uint64_t get64 ()                    { uint64_t v; bytes(&v, sizeof(v)); return v; }
+    double   getDouble()                 { double v; bytes(&v, sizeof(v)); return v; }
+    std::string getString() {
+        uint32_t n = get32();
+        if (n > 4096) { good = false; return std::string(); }
+        std::string s(n, '\0');
+        if (n > 0) bytes(&s[0], n);
+        return s; }
+    bool ok() const                      { return good; }
+    uint64_t remaining() {               // Bytes left in the file.
+        long pos = ftell(in), end;
+        if (pos < 0 || fseek(in, 0, SEEK_END) != 0) return 0;
+        end = ftell(in);
+        if (fseek(in, pos, SEEK_SET) != 0) good = false;
+        return end > pos ? end - pos : 0; }
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -22,6 +22,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #define Glucose_Dimacs_h
 
 #include <stdio.h>
+#include <algorithm>
+#include <memory>
 
 #include "utils/ParseUtils.h"
 #include "core/SolverTypes.h"
@@ -31,6 +33,10 @@ namespace Glucose {
 //=================================================================================================
 // DIMACS Parser:
 
+// The solver is pre-sized from the header, which nothing checks against the body: the counts are
+// capped, so that a wrong header does not reserve more than a large formula would use.
+static const int dimacsPresizeMax = 1 << 24;
+
 template<class B, class Solver>
 static void readClause(B& in, Solver& S, vec<Lit>& lits) {
     int     parsed_lit, var;
@@ -44,8 +50,9 @@ static void readClause(B& in, Solver& S, vec<Lit>& lits) {
     }
 }
 
+// Returns the number of variables declared in the header.
 template<class B, class Solver>
-static void parse_DIMACS_main(B& in, Solver& S) {
+static int parse_DIMACS_main(B& in, Solver& S) {
     vec<Lit> lits;
     int vars    = 0;
     int clauses = 0;
@@ -57,11 +64,14 @@ static void parse_DIMACS_main(B& in, Solver& S) {
             if (eagerMatch(in, "p cnf")){
                 vars    = parseInt(in);
                 clauses = parseInt(in);
+                if (vars < 0 || clauses < 0)
+                    parseError(stdout, "Negative count in the DIMACS header\n");
+                S.beginBulkLoad(std::min(vars, dimacsPresizeMax), std::min(clauses, dimacsPresizeMax), 0);
                 // SATRACE'06 hack
                 // if (clauses > 4000000)
                 //     S.eliminate(true);
             }else{
-                printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+                parseError(stdout, "Unexpected char: %c\n", *in);
             }
         } else if (*in == 'c' || *in == 'p')
             skipLine(in);
@@ -70,18 +80,33 @@ static void parse_DIMACS_main(B& in, Solver& S) {
             readClause(in, S, lits);
             S.addClause_(lits); }
     }
+    S.endBulkLoad();
     if (vars != S.nVars())
         fprintf(stderr, "WARNING! DIMACS header mismatch: wrong number of variables.\n");
     if (cnt  != clauses)
         fprintf(stderr, "WARNING! DIMACS header mismatch: wrong number of clauses.\n");
+    return vars;
 }
 
 // Inserts problem into solver.
 //
 template<class Solver>
-static void parse_DIMACS(gzFile input_stream, Solver& S) {
+static int parse_DIMACS(gzFile input_stream, Solver& S) {
+    StreamBuffer in(input_stream);
+    return parse_DIMACS_main(in, S); }
+
+template<class Solver>
+static int parse_DIMACS(InputStream& input_stream, Solver& S) {
     StreamBuffer in(input_stream);
-    parse_DIMACS_main(in, S); }
+    return parse_DIMACS_main(in, S); }
+
+// Opens 'file' (any format supported by InputStream, NULL for the standard input) and inserts it
+// into the solver. Exits if the file cannot be read.
+template<class Solver>
+static int parse_DIMACS(const char* file, Solver& S) {
+    std::unique_ptr<InputStream> input(InputStream::open(file));
+    if (input == NULL) parseFail(1);
+    return parse_DIMACS(*input, S); }
 
 //=================================================================================================
 }
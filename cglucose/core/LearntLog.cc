@@ -0,0 +1,175 @@
+/*
+    Logs of learnt clauses (see LearntLog.h).
+*/
+
+#include <string.h>
+#include <errno.h>
+
+#include "mtl/Sort.h"
+#include "core/LearntLog.h"
+
+using namespace Glucose;
+
+static inline void putVarint(vec<unsigned char>& out, uint64_t v)
+{
+    while (v >= 0x80) { out.push((unsigned char)(v | 0x80)); v >>= 7; }
+    out.push((unsigned char)v);
+}
+
+//=================================================================================================
+// Writing:
+
+
+LearntLog::LearntLog() : nbClauses(0), nbDropped(0), nbBytes(0), out(NULL), localClauses(0), stopping(false), failed(false) {}
+
+LearntLog::~LearntLog() { close(); }
+
+
+bool LearntLog::open(const char* file, uint64_t problem_hash, int nb_vars)
+{
+    close();
+    out = fopen(file, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "c WARNING! Could not create the learnt clause log %s: %s\n", file, strerror(errno));
+        return false; }
+
+    nbClauses = nbDropped = nbBytes = 0;
+    stopping = failed = false;
+    local.clear();
+    localClauses = 0;
+    for (int i = 0; i < 4; i++) local.push(learntLogMagic[i]);
+    putVarint(local, learntLogVersion);
+    putVarint(local, problem_hash);
+    putVarint(local, nb_vars);
+    writer = std::thread(&LearntLog::writeLoop, this);
+    return true;
+}
+
+
+void LearntLog::add(const vec<Lit>& lits, unsigned int lbd)
+{
+    if (out == NULL) return;
+    lits.copyTo(sorted);
+    sort(sorted);
+    putVarint(local, lbd);
+    putVarint(local, sorted.size());
+    for (int i = 0; i < sorted.size(); i++)
+        putVarint(local, i == 0 ? toInt(sorted[0]) : toInt(sorted[i]) - toInt(sorted[i - 1]));
+    nbClauses++;
+    localClauses++;
+    if (local.size() >= chunkSize) handOver();
+}
+
+
+// Appends the local buffer to the one of the writer, unless the writer is too far behind.
+void LearntLog::handOver()
+{
+    {
+        std::lock_guard<std::mutex> l(lock);
+        if (pending.size() + local.size() > maxPending) {
+            nbClauses -= localClauses;
+            nbDropped += localClauses;
+        } else if (pending.size() == 0)
+            local.moveTo(pending);
+        else {
+            for (int i = 0; i < local.size(); i++) pending.push(local[i]);
+        }
+    }
+    local.clear();
+    localClauses = 0;
+    wake.notify_one();
+}
+
+
+void LearntLog::writeLoop()
+{
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> l(lock);
+            wake.wait(l, [this]{ return stopping || pending.size() > 0; });
+            if (pending.size() == 0) return;   // Stopping, and everything is written.
+            pending.moveTo(writing);
+        }
+        if (fwrite((const unsigned char*)writing, 1, writing.size(), out) != (size_t)writing.size())
+            failed = true;
+        else
+            nbBytes += writing.size();
+        writing.clear();
+    }
+}
+
+
+bool LearntLog::close()
+{
+    if (out == NULL) return true;
+    if (local.size() > 0) handOver();
+    {
+        std::lock_guard<std::mutex> l(lock);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+    if (fclose(out) != 0) failed = true;
+    out = NULL;
+    return !failed && nbDropped == 0;
+}
+
+//=================================================================================================
+// Reading:
+
+
+bool LearntLogReader::readVarint(uint64_t& v)
+{
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= size) {
+            size = in != NULL ? (int)fread(buf, 1, sizeof(buf), in) : 0;
+            pos  = 0;
+            if (size <= 0) return false; }
+        unsigned char b = buf[pos++];
+        v |= (uint64_t)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+
+bool LearntLogReader::open(const char* file, uint64_t problem_hash)
+{
+    in = fopen(file, "rb");
+    if (in == NULL) {
+        fprintf(stderr, "c WARNING! Could not open the learnt clause log %s: %s\n", file, strerror(errno));
+        return false; }
+
+    char     magic[4];
+    uint64_t version, hash, vars;
+    if (fread(magic, 1, 4, in) != 4 || memcmp(magic, learntLogMagic, 4) != 0
+        || !readVarint(version) || !readVarint(hash) || !readVarint(vars)) {
+        fprintf(stderr, "c WARNING! %s is not a learnt clause log\n", file);
+        return false; }
+    if (version != learntLogVersion) {
+        fprintf(stderr, "c WARNING! %s: unsupported version %d of learnt clause log\n", file, (int)version);
+        return false; }
+    if (hash != problem_hash) {
+        fprintf(stderr, "c WARNING! %s was written for another formula, it is ignored\n", file);
+        return false; }
+    nbVars = (int)vars;
+    return true;
+}
+
+
+bool LearntLogReader::next(vec<Lit>& lits, unsigned int& lbd)
+{
+    uint64_t l, n, x;
+    if (!readVarint(l) || !readVarint(n) || n > (uint64_t)2 * nbVars) return false;
+    lbd = (unsigned int)l;
+    lits.clear();
+    uint64_t prev = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        if (!readVarint(x)) return false;
+        prev = i == 0 ? x : prev + x;
+        if (prev >= (uint64_t)2 * nbVars) return false;
+        lits.push(toLit((int)prev));
+    }
+    return true;
+}
@@ -0,0 +1,92 @@
+/*
+    Logs of learnt clauses, to seed later runs on the same formula (see Solver::openLearntLog and
+    Solver::loadLearntLog).
+
+    A log starts with a magic number and a header identifying the formula (Solver::problemHash),
+    followed by one record per clause: its LBD, its size and its literals in increasing order, the
+    literals after the first one as the difference with the previous one. Everything after the
+    magic number is a varint, so short clauses take a few bytes and the log does not depend on the
+    byte order of the machine.
+
+    The search only encodes the clauses into a local buffer. Full buffers are handed to a writer
+    thread, so the search never waits on the disk. If the writer falls behind by more than
+    'maxPending' bytes, clauses are dropped (and counted) rather than buffered without bound.
+*/
+
+#ifndef Glucose_LearntLog_h
+#define Glucose_LearntLog_h
+
+#include <stdio.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "mtl/IntTypes.h"
+#include "mtl/Vec.h"
+#include "core/SolverTypes.h"
+
+namespace Glucose {
+
+static const char     learntLogMagic[4] = { 'G', 'L', 'L', 'G' };
+static const uint32_t learntLogVersion  = 1;
+
+//=================================================================================================
+// LearntLog -- writes a log in the background:
+
+class LearntLog {
+public:
+    enum { chunkSize = 1 << 16, maxPending = 1 << 24 };
+
+    LearntLog();
+    ~LearntLog();                                                // Closes the log.
+
+    bool open (const char* file, uint64_t problem_hash, int nb_vars); // Returns false if the file cannot be created.
+    void add  (const vec<Lit>& lits, unsigned int lbd);
+    bool close();                                                // Returns false if some clauses could not be written.
+
+    uint64_t nbClauses, nbDropped, nbBytes;                      // Clauses logged and dropped, bytes written (final after 'close').
+
+protected:
+    FILE*                   out;
+    vec<unsigned char>      local;      // Encoded by the search, not yet handed to the writer.
+    int                     localClauses;
+    vec<unsigned char>      pending;    // Handed to the writer.
+    vec<unsigned char>      writing;    // Being written.
+    vec<Lit>                sorted;
+    bool                    stopping;
+    bool                    failed;
+    std::mutex              lock;
+    std::condition_variable wake;
+    std::thread             writer;
+
+    void handOver();
+    void writeLoop();
+};
+
+//=================================================================================================
+// LearntLogReader -- reads a log back:
+
+class LearntLogReader {
+public:
+    LearntLogReader() : nbVars(0), in(NULL), pos(0), size(0) {}
+    ~LearntLogReader() { if (in != NULL) fclose(in); }
+
+    // Returns false, with a message on stderr, if the file cannot be read or was not written for
+    // a formula of this hash.
+    bool open(const char* file, uint64_t problem_hash);
+    bool next(vec<Lit>& lits, unsigned int& lbd);          // Returns false at the end of the log (or on a corrupt record).
+
+    int  nbVars;
+
+protected:
+    FILE*         in;
+    unsigned char buf[1 << 16];
+    int           pos, size;
+
+    bool readVarint(uint64_t& v);
+};
+
+//=================================================================================================
+}
+
+#endif
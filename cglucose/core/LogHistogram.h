@@ -0,0 +1,115 @@
+/*
+    Log-bucketed histograms (in the spirit of HDR histograms) of non negative integers.
+
+    Values below 2^(subBits+1) have a bucket of their own, larger values share buckets of
+    2^subBits buckets per power of two, so every value is known within a relative error of
+    2^-subBits (12.5%). The memory is constant (a few KB) whatever the range of the values, and a
+    push is a count leading zeros, a shift and an increment.
+*/
+
+#ifndef Glucose_LogHistogram_h
+#define Glucose_LogHistogram_h
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mtl/IntTypes.h"
+#include "utils/JsonWriter.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// LogHistogram -- distribution of a quantity:
+
+class LogHistogram {
+public:
+    enum { subBits = 3, subBuckets = 1 << subBits, nbBuckets = (64 - subBits + 1) * subBuckets };
+
+    LogHistogram() { clear(); }
+
+    static int bucket(uint64_t v) {
+        if (v < 2 * subBuckets) return (int)v;
+        int shift = 63 - __builtin_clzll(v) - subBits;
+        return (shift + 1) * subBuckets + (int)((v >> shift) - subBuckets);
+    }
+
+    // Smallest and largest values falling into bucket 'b'.
+    static uint64_t lowest(int b) {
+        if (b < 2 * subBuckets) return b;
+        int shift = b / subBuckets - 1;
+        return (uint64_t)(subBuckets + b % subBuckets) << shift;
+    }
+    static uint64_t highest(int b) { return b + 1 < nbBuckets ? lowest(b + 1) - 1 : UINT64_MAX; }
+
+    void push(uint64_t v) {
+        int b = bucket(v);
+        counts[b]++;
+        if (b >= top) top = b + 1;
+        n++;
+        sum += v;
+        if (v > maxValue) maxValue = v;
+    }
+
+    void clear() {
+        memset(counts, 0, sizeof(counts));
+        top = 0; n = sum = maxValue = 0;
+    }
+
+    void add(const LogHistogram& h) {
+        for (int b = 0; b < h.top; b++) counts[b] += h.counts[b];
+        if (h.top > top) top = h.top;
+        n += h.n;
+        sum += h.sum;
+        if (h.maxValue > maxValue) maxValue = h.maxValue;
+    }
+
+    uint64_t count() const { return n; }
+    uint64_t max  () const { return maxValue; }
+    double   mean () const { return n == 0 ? 0 : (double)sum / n; }
+
+    // Value at the given percentile (0..100): the largest value of the bucket reaching it.
+    uint64_t percentile(double p) const {
+        if (n == 0) return 0;
+        uint64_t rank = (uint64_t)(p / 100.0 * n + 0.5), seen = 0;
+        if (rank == 0) rank = 1;
+        for (int b = 0; b < top; b++)
+            if ((seen += counts[b]) >= rank) return highest(b) < maxValue ? highest(b) : maxValue;
+        return maxValue;
+    }
+
+    void print(const char* name) const {
+        printf("c   %-20s: %10" PRIu64" mean %9.2f  p50 %7" PRIu64"  p90 %7" PRIu64"  p99 %7" PRIu64"  max %7" PRIu64"\n",
+               name, n, mean(), percentile(50), percentile(90), percentile(99), maxValue);
+    }
+
+    // An object with the summary and the non empty buckets as [lowest value, count] pairs.
+    void writeJson(JsonWriter& json, const char* key) const {
+        json.beginObject(key);
+        json.value("count", n);
+        json.value("mean", mean());
+        json.value("p50", percentile(50));
+        json.value("p90", percentile(90));
+        json.value("p99", percentile(99));
+        json.value("max", maxValue);
+        json.beginArray("buckets");
+        for (int b = 0; b < top; b++)
+            if (counts[b] > 0) {
+                json.beginArray();
+                json.value(NULL, lowest(b));
+                json.value(NULL, counts[b]);
+                json.endArray();
+            }
+        json.endArray();
+        json.endObject();
+    }
+
+protected:
+    uint64_t counts[nbBuckets];
+    int      top;       // All buckets from 'top' on are empty.
+    uint64_t n, sum, maxValue;
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,343 @@
+/*
+    Linear pseudo-Boolean problems in the OPB format of the PB competitions:
+
+        * #variable= 3 #constraint= 2
+        min: +1 x1 +2 x3 ;
+        +1 x1 +2 ~x2 -1 x3 >= 1 ;
+        +1 x1 +1 x2 +1 x3 = 2 ;
+
+    A term is an integer coefficient and a literal 'x<n>' or '~x<n>' (variable n-1 of the solver).
+    The objective function, if any, is ignored: only the satisfiability is decided. Non-linear terms
+    (products of literals) are refused.
+
+    Each constraint is normalized to 'sum w_i * l_i <= bound' with positive weights and one term per
+    variable ('=' gives two of them, '>=' is negated), then added in the cheapest form that fits:
+
+      - units and clauses when it is one (a term heavier than the bound is false, a constraint only
+        violated when all its terms are true is a clause),
+      - the clauses of its BDD when it has at most 'bdd_factor' nodes per term: the BDD of the terms
+        taken by decreasing weight, whose nodes are shared by intervals of the remaining bound as in
+        MiniSat+, each node 'n' of term 'l' giving (~n | ~l | hi) and (~n | lo),
+      - otherwise as a native constraint of the solver (see Solver::addPb_), propagated with a counter
+        of the weight of its true terms: the large cardinality constraints of scheduling problems
+        stay as compact as in the file.
+
+    The file may be compressed (see InputStream).
+*/
+
+#ifndef Glucose_Opb_h
+#define Glucose_Opb_h
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mtl/IntTypes.h"
+#include "mtl/Sort.h"
+#include "utils/ParseUtils.h"
+#include "utils/InputStream.h"
+#include "core/SolverTypes.h"
+
+namespace Glucose {
+
+static const int opbBddMaxTerms = 10000;   // Larger constraints are not tried as BDDs (the construction is recursive).
+
+// True if 'file' is named as an OPB file, possibly compressed ("x.opb", "x.opb.gz", ...).
+inline bool isOpbFile(const char* file) {
+    if (file == NULL) return false;
+    const char* ext = NULL;
+    for (const char* p = strstr(file, ".opb"); p != NULL; p = strstr(p + 1, ".opb")) ext = p;
+    return ext != NULL && (ext[4] == '\0' || (ext[4] == '.' && strchr(ext + 5, '.') == NULL && strchr(ext + 5, '/') == NULL)); }
+
+static inline int64_t opbAdd(int64_t a, int64_t b) {      // Saturated at the int64 limits.
+    int64_t r;
+    if (__builtin_add_overflow(a, b, &r)) return b > 0 ? INT64_MAX : INT64_MIN;
+    return r; }
+
+//=================================================================================================
+// OpbBdd -- the BDD of 'sum w_i * l_i <= bound', the weights in decreasing order:
+
+class OpbBdd {
+public:
+    enum { False = -1, True = -2, Aborted = -3 };
+    struct Node { int term, hi, lo; };       // 'hi' when the term is true, 'lo' when it is false.
+
+    vec<Node> nodes;                         // Children before their parents.
+    int       root;
+
+    // Builds the BDD, unless it has more than 'max_nodes' nodes ('root' is then Aborted).
+    OpbBdd(const vec<int64_t>& w, int64_t bound, int max_nodes) : weights(w), maxNodes(max_nodes) {
+        rest.growTo(w.size() + 1, 0);
+        for (int i = w.size() - 1; i >= 0; i--) rest[i] = opbAdd(rest[i + 1], w[i]);
+        memo.resize(w.size());
+        int64_t lo, hi;
+        root = build(0, bound, lo, hi); }
+
+protected:
+    struct Interval { int64_t hi; int node; };
+    const vec<int64_t>&                       weights;
+    int                                       maxNodes;
+    vec<int64_t>                              rest; // rest[i]: the weight of the terms i, i+1, ...
+    std::vector<std::map<int64_t, Interval> > memo; // memo[i][lo]: the node of the terms from i for the bounds lo .. hi.
+
+    // The node of 'sum_{j >= i} w_j * l_j <= k', and the bounds 'lo' .. 'hi' it is the node of.
+    int build(int i, int64_t k, int64_t& lo, int64_t& hi) {
+        if (k < 0)        { lo = INT64_MIN; hi = -1;        return False; }
+        if (k >= rest[i]) { lo = rest[i];   hi = INT64_MAX; return True; }
+        std::map<int64_t, Interval>::iterator it = memo[i].upper_bound(k);
+        if (it != memo[i].begin() && (--it)->second.hi >= k) { lo = it->first; hi = it->second.hi; return it->second.node; }
+
+        int64_t hlo, hhi, llo, lhi;
+        int h = build(i + 1, k - weights[i], hlo, hhi);
+        if (h == Aborted) return Aborted;
+        int l = build(i + 1, k, llo, lhi);
+        if (l == Aborted) return Aborted;
+        lo = std::max(opbAdd(hlo, weights[i]), llo);
+        hi = std::min(opbAdd(hhi, weights[i]), lhi);
+
+        int n = h;
+        if (h != l) {
+            if (nodes.size() >= maxNodes) return Aborted;
+            Node node = { i, h, l };
+            n = nodes.size();
+            nodes.push(node);
+        }
+        Interval iv = { hi, n };
+        memo[i][lo] = iv;
+        return n; }
+};
+
+//=================================================================================================
+// Encoding of a normalized constraint:
+
+// Adds 'sum weights[i] * lits[i] <= bound' (positive weights, one term per variable) to the solver.
+// Changes the vectors.
+template<class Solver>
+static void addOpbConstraint(Solver& S, vec<Lit>& lits, vec<int64_t>& weights, int64_t bound, int bdd_factor) {
+    vec<Lit> clause;
+    if (bound < 0) { S.addClause_(clause); return; }
+
+    // A term heavier than the bound is false:
+    int     i, j;
+    int64_t total = 0, lightest = INT64_MAX;
+    for (i = j = 0; i < lits.size(); i++)
+        if (weights[i] > bound) {
+            clause.clear(); clause.push(~lits[i]);
+            S.addClause_(clause);
+        } else {
+            total    = opbAdd(total, weights[i]);
+            lightest = std::min(lightest, weights[i]);
+            lits[j] = lits[i], weights[j++] = weights[i];
+        }
+    lits.shrink(i - j), weights.shrink(i - j);
+    if (total <= bound) return;
+
+    // Only violated when all the terms are true: a clause.
+    if (total - lightest <= bound) {
+        clause.clear();
+        for (i = 0; i < lits.size(); i++) clause.push(~lits[i]);
+        S.addClause_(clause);
+        return;
+    }
+
+    if (lits.size() <= opbBddMaxTerms) {
+        vec<int> order;
+        for (i = 0; i < lits.size(); i++) order.push(i);
+        struct WeightGt {
+            const vec<int64_t>& w;
+            bool operator () (int a, int b) const { return w[a] > w[b]; } } gt = { weights };
+        sort(order, gt);
+        vec<Lit>     sorted_lits;
+        vec<int64_t> sorted_weights;
+        for (i = 0; i < order.size(); i++) sorted_lits.push(lits[order[i]]), sorted_weights.push(weights[order[i]]);
+
+        OpbBdd bdd(sorted_weights, bound, (int)std::min((int64_t)bdd_factor * lits.size(), (int64_t)INT32_MAX));
+        if (bdd.root != OpbBdd::Aborted) {
+            // The root is a node: the constraint is neither trivial nor a contradiction here.
+            vec<Lit> node(bdd.nodes.size());
+            for (i = 0; i < bdd.nodes.size(); i++) node[i] = mkLit(S.newVar());
+            for (i = 0; i < bdd.nodes.size(); i++) {
+                const OpbBdd::Node& n = bdd.nodes[i];
+                if (n.hi != OpbBdd::True) {
+                    clause.clear(); clause.push(~node[i]); clause.push(~sorted_lits[n.term]);
+                    if (n.hi != OpbBdd::False) clause.push(node[n.hi]);
+                    S.addClause_(clause);
+                }
+                if (n.lo != OpbBdd::True) {
+                    assert(n.lo != OpbBdd::False);
+                    clause.clear(); clause.push(~node[i]); clause.push(node[n.lo]);
+                    S.addClause_(clause);
+                }
+            }
+            clause.clear(); clause.push(node[bdd.root]);
+            S.addClause_(clause);
+            return;
+        }
+    }
+
+    S.addPb_(lits, weights, bound);
+}
+
+//=================================================================================================
+// OPB Parser:
+
+template<class B>
+static int64_t parseOpbInt(B& in) {
+    bool neg = false;
+    if      (*in == '-') neg = true, ++in;
+    else if (*in == '+') ++in;
+    skipWhitespace(in);
+    if (*in < '0' || *in > '9') parseError(stderr, "Unexpected char in OPB file: %c\n", *in);
+    int64_t v = 0;
+    while (*in >= '0' && *in <= '9') {
+        if (v > (INT64_MAX - 9) / 10) parseError(stderr, "Coefficient too large in OPB file\n");
+        v = v * 10 + (*in - '0'), ++in; }
+    return neg ? -v : v; }
+
+// Reads the terms up to the relation (or the ';' of the objective) into 'coefs' (per variable, on its
+// positive literal), 'vars' (the variables with a non-zero coefficient) and 'offset' (the constant
+// the negative literals add).
+template<class B>
+static void parseOpbTerms(B& in, vec<int64_t>& coefs, vec<Var>& vars, int64_t& offset) {
+    vars.clear();
+    offset = 0;
+    for (;;) {
+        skipWhitespace(in);
+        if (*in == '>' || *in == '<' || *in == '=' || *in == ';') return;
+        if (*in == EOF) parseError(stderr, "Unterminated constraint in OPB file\n");
+        int64_t c = *in == 'x' || *in == '~' ? 1 : parseOpbInt(in);
+        skipWhitespace(in);
+        bool neg = false;
+        if (*in == '~') neg = true, ++in;
+        if (*in != 'x') parseError(stderr, "Expected a literal in OPB file: %c\n", *in);
+        ++in;
+        if (*in < '1' || *in > '9') parseError(stderr, "Invalid variable in OPB file\n");
+        Var v = parseInt(in) - 1;
+        skipWhitespace(in);
+        if (*in == 'x' || *in == '~') parseError(stderr, "Non-linear term in OPB file (variable x%d)\n", v + 1);
+
+        if (coefs.size() <= v) coefs.growTo(v + 1, 0);
+        if (coefs[v] == 0) vars.push(v);
+        if (neg) {                  // c * ~x = c - c * x
+            offset = opbAdd(offset, c);
+            c = -c; }
+        coefs[v] = opbAdd(coefs[v], c);
+        if (coefs[v] == INT64_MAX || coefs[v] == INT64_MIN || offset == INT64_MAX || offset == INT64_MIN)
+            parseError(stderr, "Coefficients too large in OPB file\n");
+        if (coefs[v] == 0) {        // Cancelled out: may come back.
+            for (int i = 0; i < vars.size(); i++)
+                if (vars[i] == v) { vars[i] = vars.last(); vars.pop(); break; }
+        }
+    }
+}
+
+// Normalizes 'sign * (sum coefs[v] * v + offset) <= sign * rhs' into 'sum w_i * l_i <= bound' and
+// appends it to the constraints.
+inline void pushOpbConstraint(const vec<int64_t>& coefs, const vec<Var>& vars, int64_t offset, int64_t rhs, int sign,
+                              vec<Lit>& lits, vec<int64_t>& weights, vec<int>& starts, vec<int64_t>& bounds) {
+    int64_t bound = opbAdd(sign * rhs, -sign * offset);
+    for (int i = 0; i < vars.size(); i++) {
+        int64_t c = sign * coefs[vars[i]];
+        if (c > 0) lits.push(mkLit(vars[i])), weights.push(c);
+        else       lits.push(~mkLit(vars[i])), weights.push(-c), bound = opbAdd(bound, -c);  // c * x = c - c * ~x
+    }
+    if (bound == INT64_MAX || bound == INT64_MIN) parseError(stderr, "Coefficients too large in OPB file\n");
+    bounds.push(bound);
+    starts.push(lits.size());
+}
+
+// Returns the number of variables declared in the header (or used, if more).
+template<class B, class Solver>
+static int parse_OPB_main(B& in, Solver& S, int bdd_factor) {
+    vec<int64_t> coefs;
+    vec<Var>     vars;
+    vec<Lit>     lits;             // The normalized constraints, one after the other.
+    vec<int64_t> weights, bounds;
+    vec<int>     starts;
+    int          declared_vars = 0, declared_constraints = -1, constraints = 0;
+    Var          max_var = -1;
+    bool         objective = false;
+    starts.push(0);
+
+    for (;;) {
+        skipWhitespace(in);
+        if (*in == EOF) break;
+        if (*in == '*') {
+            std::string line;
+            for (; *in != EOF && *in != '\n'; ++in) line += (char)*in;
+            const char* v = strstr(line.c_str(), "#variable=");
+            const char* c = strstr(line.c_str(), "#constraint=");
+            if (v != NULL) declared_vars        = atoi(v + 10);
+            if (c != NULL) declared_constraints = atoi(c + 12);
+            continue;
+        }
+
+        bool obj = *in == 'm';
+        if (obj) {
+            if (!eagerMatch(in, "min:")) parseError(stderr, "Unexpected char in OPB file: %c\n", *in);
+            objective = true;
+        }
+        int64_t offset;
+        parseOpbTerms(in, coefs, vars, offset);
+        for (int i = 0; i < vars.size(); i++) max_var = std::max(max_var, vars[i]);
+
+        int rel = 0;                   // 1: >=, -1: <=, 0: =
+        if (!obj) {
+            if      (*in == '>') rel =  1, ++in;
+            else if (*in == '<') rel = -1, ++in;
+            else if (*in != '=') parseError(stderr, "Expected a relation in OPB file\n");
+            if (*in != '=') parseError(stderr, "Expected a relation in OPB file\n");
+            ++in;
+            skipWhitespace(in);
+            int64_t rhs = parseOpbInt(in);
+            skipWhitespace(in);
+            if (rel <= 0) pushOpbConstraint(coefs, vars, offset, rhs,  1, lits, weights, starts, bounds);
+            if (rel >= 0) pushOpbConstraint(coefs, vars, offset, rhs, -1, lits, weights, starts, bounds);
+            constraints++;
+        }
+        if (*in != ';') parseError(stderr, "Expected ';' in OPB file: %c\n", *in);
+        ++in;
+        for (int i = 0; i < vars.size(); i++) coefs[vars[i]] = 0;
+    }
+
+    // The variables of the problem come first, then the ones of the BDDs.
+    int nb_vars = std::max(declared_vars, max_var + 1);
+    while (S.nVars() < nb_vars) S.newVar();
+    vec<Lit>     cl;
+    vec<int64_t> cw;
+    for (int i = 0; i < bounds.size(); i++) {
+        cl.clear(), cw.clear();
+        for (int k = starts[i]; k < starts[i + 1]; k++) cl.push(lits[k]), cw.push(weights[k]);
+        addOpbConstraint(S, cl, cw, bounds[i], bdd_factor);
+    }
+
+    if (objective)
+        fprintf(stderr, "WARNING! OPB objective function ignored: only the satisfiability is decided.\n");
+    if (declared_vars != 0 && declared_vars <= max_var)
+        fprintf(stderr, "WARNING! OPB header mismatch: wrong number of variables.\n");
+    if (declared_constraints >= 0 && declared_constraints != constraints)
+        fprintf(stderr, "WARNING! OPB header mismatch: wrong number of constraints.\n");
+    return nb_vars;
+}
+
+template<class Solver>
+static int parse_OPB(InputStream& input, Solver& S, int bdd_factor) {
+    StreamBuffer in(input);
+    return parse_OPB_main(in, S, bdd_factor); }
+
+// Opens 'file' (any format supported by InputStream, NULL for the standard input) and inserts it
+// into the solver. Exits if the file cannot be read.
+template<class Solver>
+static int parse_OPB(const char* file, Solver& S, int bdd_factor) {
+    std::unique_ptr<InputStream> input(InputStream::open(file));
+    if (input == NULL) parseFail(1);
+    return parse_OPB(*input, S, bdd_factor); }
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,199 @@
+/*
+    Persistent cache of the answers of the solver (see ResultCache.h).
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "mtl/Sort.h"
+#include "core/ResultCache.h"
+
+using namespace Glucose;
+
+static const int resultCacheVersion = 1;
+
+static inline int toDimacs(Lit p) { return sign(p) ? -(var(p) + 1) : var(p) + 1; }
+
+// Reads DIMACS literals up to the terminating 0. Returns false on a malformed list.
+static bool readLits(FILE* in, vec<Lit>& lits)
+{
+    lits.clear();
+    for (int v; fscanf(in, "%d", &v) == 1;) {
+        if (v == 0) return true;
+        lits.push(v > 0 ? mkLit(v - 1) : ~mkLit(-v - 1));
+    }
+    return false;
+}
+
+
+//=================================================================================================
+// Hash of an input file:
+
+
+InputHash::InputHash() : first(true), raw(false), lineStart(true), comment(false), space(false), started(false) {}
+
+
+void InputHash::update(const unsigned char* buf, int n)
+{
+    if (first && n >= 4 && (memcmp(buf, "GBCN", 4) == 0 || memcmp(buf, "NCBG", 4) == 0)) raw = true;
+    first = false;
+    if (raw) { h.update(buf, n); return; }
+
+    out.clear();
+    for (int i = 0; i < n; i++) {
+        unsigned char c = buf[i];
+        if (comment) {
+            if (c == '\n') comment = false, lineStart = true;
+        } else if (c == ' ' || (c >= 9 && c <= 13)) {
+            if (c == '\n') lineStart = true;
+            space = started;
+        } else if (lineStart && (c == 'c' || c == '*'))
+            comment = true;
+        else {
+            if (space) out.push(' ');
+            out.push(c);
+            lineStart = space = false;
+            started = true;
+        }
+    }
+    h.update(out, out.size());
+}
+
+
+bool ResultCache::hashInput(const char* file, uint64_t& hash)
+{
+    InputStream* input = InputStream::open(file);
+    if (input == NULL) return false;
+
+    InputHash          h;
+    static const int   chunk = 1 << 16;
+    vec<unsigned char> in(chunk);
+    int                n;
+    while ((n = input->read(in, chunk)) > 0)
+        h.update(in, n);
+    delete input;
+    if (n < 0) {
+        fprintf(stderr, "c WARNING! Corrupt or truncated input %s\n", file);
+        return false;
+    }
+    hash = h.digest();
+    return true;
+}
+
+
+//=================================================================================================
+// Entries:
+
+
+ResultCache::ResultCache(const char* d) : nbHits(0), nbMisses(0), nbStores(0), dir(d)
+{
+    if (mkdir(d, 0777) != 0 && errno != EEXIST)
+        fprintf(stderr, "c WARNING! Could not create the cache directory %s: %s\n", d, strerror(errno));
+}
+
+
+std::string ResultCache::entryFile(uint64_t formula, const vec<Lit>& assumps)
+{
+    assumps.copyTo(sorted);
+    sort(sorted);
+    int i, j;
+    for (i = j = 0; i < sorted.size(); i++)
+        if (j == 0 || sorted[i] != sorted[j - 1]) sorted[j++] = sorted[i];
+    sorted.shrink(i - j);
+
+    StreamHash h;
+    for (i = 0; i < sorted.size(); i++) h.update64(toInt(sorted[i]));
+    char name[64];
+    snprintf(name, sizeof(name), "/%016" PRIx64 "-%016" PRIx64, formula, h.digest());
+    return dir + name;
+}
+
+
+bool ResultCache::lookup(uint64_t formula, const vec<Lit>& assumps, Entry& entry)
+{
+    entry.status = l_Undef;
+    entry.model.clear();
+    entry.core.clear();
+
+    FILE* in = fopen(entryFile(formula, assumps).c_str(), "rb");
+    if (in == NULL) { nbMisses++; return false; }
+
+    char     word[32];
+    int      version;
+    uint64_t f;
+    bool     ok = fscanf(in, "%31s %d", word, &version) == 2 && strcmp(word, "glucose-cache") == 0 && version == resultCacheVersion;
+    vec<Lit> lits;
+    for (char tag; ok && fscanf(in, " %c", &tag) == 1;)
+        switch (tag) {
+        case 'f': ok = fscanf(in, "%" SCNx64, &f) == 1 && f == formula; break;
+        case 'a':
+            ok = readLits(in, lits) && lits.size() == sorted.size();
+            for (int i = 0; ok && i < lits.size(); i++) ok = lits[i] == sorted[i];
+            break;
+        case 's':
+            ok = fscanf(in, "%31s", word) == 1;
+            if      (ok && strcmp(word, "SAT")   == 0) entry.status = l_True;
+            else if (ok && strcmp(word, "UNSAT") == 0) entry.status = l_False;
+            else ok = false;
+            break;
+        case 'v':
+            ok = readLits(in, lits);
+            for (int i = 0; ok && i < lits.size(); i++) {
+                entry.model.growTo(var(lits[i]) + 1, l_Undef);
+                entry.model[var(lits[i])] = lbool(!sign(lits[i]));
+            }
+            break;
+        case 'u': ok = readLits(in, entry.core); break;
+        default:  ok = false;
+        }
+    fclose(in);
+
+    if (!ok || entry.status == l_Undef) {
+        entry.status = l_Undef;
+        nbMisses++;
+        return false;
+    }
+    nbHits++;
+    return true;
+}
+
+
+bool ResultCache::store(uint64_t formula, const vec<Lit>& assumps, lbool status, const vec<lbool>& model, const vec<Lit>& core)
+{
+    assert(status != l_Undef);
+    std::string file = entryFile(formula, assumps);
+    std::string tmp  = file + ".tmp." + std::to_string((long)getpid());
+    FILE* out = fopen(tmp.c_str(), "wb");
+    if (out == NULL) {
+        fprintf(stderr, "c WARNING! Could not write the cache entry %s: %s\n", tmp.c_str(), strerror(errno));
+        return false;
+    }
+
+    fprintf(out, "glucose-cache %d\nf %016" PRIx64 "\na", resultCacheVersion, formula);
+    for (int i = 0; i < sorted.size(); i++) fprintf(out, " %d", toDimacs(sorted[i]));
+    fprintf(out, " 0\ns %s\n", status == l_True ? "SAT" : "UNSAT");
+    if (status == l_True && model.size() > 0) {
+        fprintf(out, "v");
+        for (int i = 0; i < model.size(); i++)
+            if (model[i] != l_Undef) fprintf(out, " %d", model[i] == l_True ? i + 1 : -(i + 1));
+        fprintf(out, " 0\n");
+    }
+    if (status == l_False && core.size() > 0) {
+        fprintf(out, "u");
+        for (int i = 0; i < core.size(); i++) fprintf(out, " %d", toDimacs(core[i]));
+        fprintf(out, " 0\n");
+    }
+
+    bool ok = !ferror(out);
+    ok = fclose(out) == 0 && ok;
+    if (!ok || rename(tmp.c_str(), file.c_str()) != 0) {
+        fprintf(stderr, "c WARNING! Could not write the cache entry %s: %s\n", file.c_str(), strerror(errno));
+        ::remove(tmp.c_str());
+        return false;
+    }
+    nbStores++;
+    return true;
+}
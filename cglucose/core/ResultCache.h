@@ -0,0 +1,111 @@
+/*
+    Persistent cache of the answers of the solver, for queries that come back identical.
+
+    A query is a formula and a set of assumptions. The formula is identified by a 64 bits hash: the
+    one of its input file (see InputHash), computed by the parse as it reads the file through a
+    HashedInputStream, or Solver::problemHash for a formula built through the API. The assumptions
+    are sorted, so their order does not matter.
+
+    The cache is a directory with one small text file per query, named after the hashes of the
+    formula and of the assumptions:
+
+        glucose-cache 1
+        f <formula hash>
+        a <assumptions, DIMACS literals> 0
+        s SAT | UNSAT
+        v <model, DIMACS literals> 0                 (if SAT and the model was stored)
+        u <failed assumptions> 0                     (if UNSAT under assumptions and the core was stored)
+
+    The formula hash and the assumptions are checked when an entry is read back, so two queries
+    whose names collide are not mistaken for each other. An entry is written to a temporary file and
+    renamed, so concurrent runs sharing a cache see complete entries only. A file that cannot be
+    read or parsed is a miss.
+*/
+
+#ifndef Glucose_ResultCache_h
+#define Glucose_ResultCache_h
+
+#include <string>
+
+#include "mtl/IntTypes.h"
+#include "mtl/Vec.h"
+#include "utils/Hash.h"
+#include "utils/InputStream.h"
+#include "core/SolverTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// InputHash -- hash of the content of an input file, fed with its bytes as they are read:
+//
+// The text formats are normalized: comment lines ("c" of DIMACS, "*" of OPB) are skipped and every
+// run of white space counts as one, so the hash does not depend on the comments nor on the layout.
+// A binary CNF file (see BinaryCnf.h) is hashed as it is.
+
+class InputHash {
+public:
+    InputHash();
+    void     update(const unsigned char* buf, int n);
+    uint64_t digest() const { return h.digest(); }
+
+protected:
+    StreamHash         h;
+    vec<unsigned char> out;
+    bool               first, raw, lineStart, comment, space, started;
+};
+
+//=================================================================================================
+// HashedInputStream -- an input stream which hashes the bytes read through it:
+
+class HashedInputStream : public InputStream {
+public:
+    explicit HashedInputStream(InputStream& i) : in(i) {}
+
+    virtual int    read  (unsigned char* buf, int n) { int r = in.read(buf, n); if (r > 0) hash.update(buf, r); return r; }
+    virtual Format format() const                    { return in.format(); }
+
+    InputHash hash;
+
+protected:
+    InputStream& in;
+};
+
+//=================================================================================================
+// ResultCache -- answers stored in a directory:
+
+class ResultCache {
+public:
+    struct Entry {
+        lbool      status;       // l_Undef for a miss.
+        vec<lbool> model;        // The value of variable 'v' at index 'v' (empty if not stored).
+        vec<Lit>   core;         // The failed assumptions, as in Solver::conflict (empty if not stored).
+        Entry() : status(l_Undef) {}
+    };
+
+    explicit ResultCache(const char* dir);   // The directory is created if needed.
+
+    // The InputHash of a whole file (after decompression, see InputStream), for the inputs which are
+    // not parsed through an InputStream. Returns false (with a message on stderr) if the file
+    // cannot be read.
+    static bool hashInput(const char* file, uint64_t& hash);
+
+    // Fills 'entry' with the stored answer of the query, if any. Returns false on a miss.
+    bool lookup(uint64_t formula, const vec<Lit>& assumps, Entry& entry);
+
+    // Stores the answer of a query ('status' l_True or l_False). 'model' and 'core' may be empty.
+    // Returns false (with a warning) if the entry could not be written.
+    bool store (uint64_t formula, const vec<Lit>& assumps, lbool status, const vec<lbool>& model, const vec<Lit>& core);
+
+    uint64_t nbHits, nbMisses, nbStores;
+
+protected:
+    std::string dir;
+    vec<Lit>    sorted;
+
+    std::string entryFile(uint64_t formula, const vec<Lit>& assumps);   // Sets 'sorted'.
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -53,11 +53,18 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "mtl/Sort.h"
 #include "core/Solver.h"
 #include "core/Constants.h"
+#include "core/LearntLog.h"
+#include "utils/Hash.h"
+#include "utils/InputStream.h"
+#include "core/BinaryCnf.h"
+#include "core/Opb.h"
 #include "Solver.h"
 
 #include <iostream>
 #include <thread>
+#include <mutex>
 #include <cstring>
+#include <errno.h>
 #include <dlfcn.h> // For loading dynamic libraries
 
 using namespace Glucose;
@@ -69,6 +76,7 @@ static const char* _cat = "CORE";
 static const char* _cr = "CORE -- RESTART";
 static const char* _cred = "CORE -- REDUCE";
 static const char* _cm = "CORE -- MINIMIZE";
+static const char* _cbdd = "CORE -- BDD";
 
 
 static DoubleOption opt_K(_cr, "K", "The constant used to force restart", 0.8, DoubleRange(0, false, 1, false));
@@ -95,6 +103,27 @@ static IntOption opt_phase_saving(_cat, "phase-saving", "Controls the level of p
 static BoolOption opt_rnd_init_act(_cat, "rnd-init", "Randomize the initial activity", false);
 static DoubleOption opt_garbage_frac(_cat, "gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered", 0.20, DoubleRange(0, false, HUGE_VAL, false));
 
+static BoolOption opt_bdd_strengthen(_cbdd, "bdd-strengthen", "Send long learnt clauses with small LBD to the BDD side to get shorter implied sub-clauses (with -certified, only the few implied by unit propagation are kept)", false);
+static IntOption opt_bdd_str_size(_cbdd, "bdd-str-size", "The min size of a learnt clause to be strengthened by the BDD side", 12, IntRange(3, INT32_MAX));
+static IntOption opt_bdd_str_lbd(_cbdd, "bdd-str-lbd", "The max LBD of a learnt clause to be strengthened by the BDD side", 6, IntRange(1, INT32_MAX));
+static IntOption opt_bdd_str_buckets(_cbdd, "bdd-str-buckets", "The max number of BDD buckets the variables of a strengthened clause may fall into", 4, IntRange(1, INT32_MAX));
+static DoubleOption opt_bdd_mem_frac(_cbdd, "bdd-mem-frac", "The fraction of the memory budget (see -mem-lim) given to the BDD side", 0.5, DoubleRange(0, true, 1, true));
+static IntOption opt_bdd_node_bytes(_cbdd, "bdd-node-bytes", "The estimated size of a BDD node in bytes", 32, IntRange(1, INT32_MAX));
+static IntOption opt_bdd_pause(_cbdd, "bdd-pause", "The number of restarts without BDD calls when the BDD side exceeds its node budget (doubled each time)", 8, IntRange(1, INT32_MAX));
+
+static BoolOption opt_time_phases(_cat, "phase-times", "Measure the time spent in each phase of the search (reads the time stamp counter at every phase change)", false);
+static BoolOption opt_perf_counters(_cat, "perf", "Attribute hardware performance counters to the phases of the search (Linux, slow)", false);
+static StringOption opt_checkpoint(_cat, "checkpoint", "Write checkpoints of the search to this file (at restarts, see -checkpoint-every and SIGUSR2)");
+static IntOption opt_checkpoint_every(_cat, "checkpoint-every", "Wall time in seconds between two checkpoints (0 means only on SIGUSR2)", 0, IntRange(0, INT32_MAX));
+static IntOption opt_warm_size(_cat, "warm-size", "Max size of the learnt clauses exported for a warm start", 8, IntRange(1, INT32_MAX));
+static IntOption opt_warm_lbd(_cat, "warm-lbd", "Max LBD of the learnt clauses exported for a warm start", 3, IntRange(1, INT32_MAX));
+static IntOption opt_learnt_log_lbd(_cat, "learnt-log-lbd", "Max LBD of the learnt clauses written to the log of -learnt-log (units and binaries always are)", 2, IntRange(1, INT32_MAX));
+static BoolOption opt_histograms(_cat, "hist", "Maintain histograms of LBD, learnt size, backjump distance, trail length and BDD lemma size", true);
+static IntOption opt_hist_window(_cat, "hist-window", "Report the histograms of every window of this many restarts (0 means never)", 0, IntRange(0, INT32_MAX));
+static StringOption opt_hist_file(_cat, "hist-file", "Append the window reports of the histograms to this file (JSON lines, default: print them)");
+static BoolOption opt_account_memory(_cat, "mem-account", "Account the memory of each data structure (with high water marks)", true);
+static StringOption opt_snapshot_file(_cat, "snapshot-file", "Append the statistics snapshots requested with SIGUSR1 to this file (default: stderr)");
+
 
 //=================================================================================================
 // Constructor/Destructor:
@@ -125,6 +154,33 @@ verbosity(0)
 , rnd_pol(false)
 , rnd_init_act(opt_rnd_init_act)
 , garbage_frac(opt_garbage_frac)
+, bddStrengthen(opt_bdd_strengthen)
+, bddStrengthenMinSize(opt_bdd_str_size)
+, bddStrengthenMaxLBD(opt_bdd_str_lbd)
+, bddStrengthenMaxBuckets(opt_bdd_str_buckets)
+, bddMemFrac(opt_bdd_mem_frac)
+, bddNodeBytes(opt_bdd_node_bytes)
+, bddPauseRestarts(opt_bdd_pause)
+, arenaMemBudget(0)
+, bddNodeBudget(0)
+, timePhases(opt_time_phases)
+, perfCounters(opt_perf_counters)
+, perf(NULL)
+, checkpointFile(opt_checkpoint)
+, checkpointEvery(opt_checkpoint_every)
+, checkpointName(NULL)
+, nbCheckpoints(0)
+, warmMaxSize(opt_warm_size)
+, warmMaxLBD(opt_warm_lbd)
+, nbWarmClauses(0), nbWarmHints(0)
+, learntLogLBD(opt_learnt_log_lbd)
+, nbSeededClauses(0)
+, histograms(opt_histograms)
+, histWindow(opt_hist_window)
+, histFile(opt_hist_file)
+, accountMemory(opt_account_memory)
+, snapshotOnRequest(true)
+, snapshotFile(opt_snapshot_file)
 , certifiedOutput(NULL)
 , certifiedUNSAT(false) // Not in the first parallel version 
 , panicModeLastRemoved(0), panicModeLastRemovedShared(0)
@@ -139,6 +195,10 @@ verbosity(0)
 , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0), conflictsRestarts(0)
 , nbstopsrestarts(0), nbstopsrestartssame(0), lastblockatrestart(0)
 , dec_vars(0), clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
+, nbBddStrengthened(0), nbBddStrengthenedLits(0)
+, nbBddShrinks(0), nbBddPauses(0), bddPeakNodes(0), nbArenaReductions(0)
+, nbBddRuns(0), nbBddLitsSent(0), nbBddClauses(0), bddTime(0)
+, nbPbPropagations(0), nbPbConflicts(0)
 , curRestart(1)
 
 , ok(true)
@@ -155,12 +215,18 @@ verbosity(0)
 , remove_satisfied(true)
 , reduceOnSize(false) // 
 , reduceOnSizeSize(12) // Constant to use on size reductions
+, pbHead(0)
+, pbPurgeAt(1024)
 ,lastLearntClause(CRef_Undef)
 // Resource constraints:
 //
 , conflict_budget(-1)
 , propagation_budget(-1)
 , asynch_interrupt(false)
+, checkpointsSeen(checkpointRequests)
+, lastCheckpoint(0)
+, snapshotsSeen(snapshotRequests)
+, learntLog(NULL)
 , incremental(false)
 , nbVarsInitialFormula(INT32_MAX)
 , totalTime4Sat(0.)
@@ -175,6 +241,13 @@ verbosity(0)
     trailQueue.initSize(sizeTrailQueue);
     sumLBD = 0;
     nbclausesbeforereduce = firstReduceDB;
+    bddPausedUntil = 0;
+    bddPauseLength = bddPauseRestarts;
+    lastArenaReduction = 0;
+    bddLib = NULL;
+    bddStateOrdering = NULL;
+    bddBuckets = NULL;
+    bddClauseDb = NULL;
 }
 
 //-------------------------------------------------------
@@ -204,6 +277,33 @@ Solver::Solver(const Solver &s) :
 , rnd_pol(s.rnd_pol)
 , rnd_init_act(s.rnd_init_act)
 , garbage_frac(s.garbage_frac)
+, bddStrengthen(s.bddStrengthen)
+, bddStrengthenMinSize(s.bddStrengthenMinSize)
+, bddStrengthenMaxLBD(s.bddStrengthenMaxLBD)
+, bddStrengthenMaxBuckets(s.bddStrengthenMaxBuckets)
+, bddMemFrac(s.bddMemFrac)
+, bddNodeBytes(s.bddNodeBytes)
+, bddPauseRestarts(s.bddPauseRestarts)
+, arenaMemBudget(s.arenaMemBudget)
+, bddNodeBudget(s.bddNodeBudget)
+, timePhases(s.timePhases)
+, perfCounters(s.perfCounters)
+, perf(NULL) // Counters belong to a thread, a clone opens its own
+, checkpointFile(s.checkpointFile)
+, checkpointEvery(s.checkpointEvery)
+, checkpointName(s.checkpointName)
+, nbCheckpoints(0)
+, warmMaxSize(s.warmMaxSize)
+, warmMaxLBD(s.warmMaxLBD)
+, nbWarmClauses(0), nbWarmHints(0)
+, learntLogLBD(s.learntLogLBD)
+, nbSeededClauses(0)
+, histograms(s.histograms)
+, histWindow(s.histWindow)
+, histFile(s.histFile)
+, accountMemory(s.accountMemory)
+, snapshotOnRequest(s.snapshotOnRequest)
+, snapshotFile(s.snapshotFile)
 , certifiedOutput(NULL)
 , certifiedUNSAT(false) // Not in the first parallel version 
 , panicModeLastRemoved(s.panicModeLastRemoved), panicModeLastRemovedShared(s.panicModeLastRemovedShared)
@@ -222,6 +322,10 @@ Solver::Solver(const Solver &s) :
 , lastblockatrestart(s.lastblockatrestart)
 , dec_vars(s.dec_vars), clauses_literals(s.clauses_literals)
 , learnts_literals(s.learnts_literals), max_literals(s.max_literals), tot_literals(s.tot_literals)
+, nbBddStrengthened(s.nbBddStrengthened), nbBddStrengthenedLits(s.nbBddStrengthenedLits)
+, nbBddShrinks(s.nbBddShrinks), nbBddPauses(s.nbBddPauses), bddPeakNodes(s.bddPeakNodes), nbArenaReductions(s.nbArenaReductions)
+, nbBddRuns(s.nbBddRuns), nbBddLitsSent(s.nbBddLitsSent), nbBddClauses(s.nbBddClauses), bddTime(s.bddTime)
+, nbPbPropagations(s.nbPbPropagations), nbPbConflicts(s.nbPbConflicts)
 , curRestart(s.curRestart)
 
 , ok(true)
@@ -238,12 +342,18 @@ Solver::Solver(const Solver &s) :
 , remove_satisfied(s.remove_satisfied)
 , reduceOnSize(s.reduceOnSize) // 
 , reduceOnSizeSize(s.reduceOnSizeSize) // Constant to use on size reductions
+, pbHead(s.pbHead)
+, pbPurgeAt(s.pbPurgeAt)
 ,lastLearntClause(CRef_Undef)
 // Resource constraints:
 //
 , conflict_budget(s.conflict_budget)
 , propagation_budget(s.propagation_budget)
 , asynch_interrupt(s.asynch_interrupt)
+, checkpointsSeen(s.checkpointsSeen)
+, lastCheckpoint(s.lastCheckpoint)
+, snapshotsSeen(s.snapshotsSeen)
+, learntLog(NULL)
 , incremental(s.incremental)
 , nbVarsInitialFormula(s.nbVarsInitialFormula)
 , totalTime4Sat(s.totalTime4Sat)
@@ -261,6 +371,13 @@ Solver::Solver(const Solver &s) :
     // Kept here for simplicity
     sumLBD = s.sumLBD;
     nbclausesbeforereduce = s.nbclausesbeforereduce;
+    bddPausedUntil = s.bddPausedUntil;
+    bddPauseLength = s.bddPauseLength;
+    lastArenaReduction = s.lastArenaReduction;
+    bddLib = NULL;                     // A clone builds its own state of the BDD side
+    bddStateOrdering = NULL;
+    bddBuckets = NULL;
+    bddClauseDb = NULL;
    
     // Copy all search vectors
     s.watches.copyTo(watches);
@@ -277,6 +394,12 @@ Solver::Solver(const Solver &s) :
     s.order_heap.copyTo(order_heap);
     s.clauses.memCopyTo(clauses);
     s.learnts.memCopyTo(learnts);
+    s.pbs.memCopyTo(pbs);
+    s.pbLits.memCopyTo(pbLits);
+    s.pbWeights.memCopyTo(pbWeights);
+    pbOccs.growTo(s.pbOccs.size());
+    for (int i = 0; i < s.pbOccs.size(); i++) s.pbOccs[i].memCopyTo(pbOccs[i]);
+    s.pbReasons.memCopyTo(pbReasons);
 
     s.lbdQueue.copyTo(lbdQueue);
     s.trailQueue.copyTo(trailQueue);
@@ -284,6 +407,9 @@ Solver::Solver(const Solver &s) :
 }
 
 Solver::~Solver() {
+    releaseBddState();
+    delete perf;
+    delete learntLog;
 }
 
 /****************************************************************
@@ -335,6 +461,23 @@ Var Solver::newVar(bool sign, bool dvar) {
     return v;
 }
 
+void Solver::beginBulkLoad(int nb_vars, uint64_t nb_clauses, uint64_t nb_lits) {
+    if (nb_vars > 0) {
+        watches     .init(mkLit(nb_vars - 1, true));
+        watchesBin  .init(mkLit(nb_vars - 1, true));
+        unaryWatches.init(mkLit(nb_vars - 1, true)); }
+    assigns .capacity(nb_vars);
+    vardata .capacity(nb_vars);
+    activity.capacity(nb_vars);
+    seen    .capacity(nb_vars);
+    permDiff.capacity(nb_vars);
+    polarity.capacity(nb_vars);
+    decision.capacity(nb_vars);
+    trail   .capacity(nb_vars);
+    if (nb_clauses < INT32_MAX) clauses.capacity((int)nb_clauses);
+    ca.reserveClauses(nb_clauses, nb_lits);
+}
+
 bool Solver::addClause_(vec<Lit>& ps) {
 
     assert(decisionLevel() == 0);
@@ -389,6 +532,67 @@ bool Solver::addClause_(vec<Lit>& ps) {
     return true;
 }
 
+
+struct PbWeightGt {
+    const vec<int64_t>& weights;
+    bool operator () (int i, int j) const { return weights[i] > weights[j]; }
+    PbWeightGt(const vec<int64_t>& w) : weights(w) { }
+};
+
+bool Solver::addPb_(vec<Lit>& lits, vec<int64_t>& weights, int64_t bound) {
+    assert(decisionLevel() == 0);
+    assert(lits.size() == weights.size());
+    if (!ok) return false;
+
+    // The sums of the constraints must count the level 0 assignments before a new one comes
+    if (pbs.size() == 0)
+        pbHead = trail.size();
+    else if (propagate() != CRef_Undef)
+        return ok = false;
+
+    // Remove the terms assigned at level 0, the true ones use up the bound:
+    int i, j;
+    for (i = j = 0; i < lits.size(); i++) {
+        assert(weights[i] > 0);
+        if (value(lits[i]) == l_True) {
+            if ((bound -= weights[i]) < 0) return ok = false;
+        } else if (value(lits[i]) == l_Undef)
+            lits[j] = lits[i], weights[j++] = weights[i];
+    }
+    lits.shrink(i - j), weights.shrink(i - j);
+    if (bound < 0) return ok = false;
+
+    // A term heavier than the bound is false:
+    int64_t total = 0;
+    for (i = j = 0; i < lits.size(); i++)
+        if (weights[i] > bound)
+            uncheckedEnqueue(~lits[i]);
+        else {
+            total = total > bound - weights[i] ? bound + 1 : total + weights[i];
+            lits[j] = lits[i], weights[j++] = weights[i];
+        }
+    lits.shrink(i - j), weights.shrink(i - j);
+
+    if (total > bound) {
+        // Not satisfied by every assignment: store the terms by decreasing weight
+        vec<int> order;
+        for (i = 0; i < lits.size(); i++) order.push(i);
+        sort(order, PbWeightGt(weights));
+
+        PbConstraint c = { pbLits.size(), lits.size(), bound, 0 };
+        pbOccs.growTo(2 * nVars());
+        for (i = 0; i < order.size(); i++) {
+            PbOcc o = { pbs.size(), weights[order[i]] };
+            pbLits.push(lits[order[i]]);
+            pbWeights.push(weights[order[i]]);
+            pbOccs[toInt(lits[order[i]])].push(o);
+        }
+        pbs.push(c);
+    }
+
+    return ok = (propagate() == CRef_Undef);
+}
+
 void Solver::attachClause(CRef cr) {
     const Clause& c = ca[cr];
 
@@ -488,6 +692,27 @@ bool Solver::satisfied(const Clause& c) const {
     return false;
 }
 
+// Check if the clause is implied by unit propagation at level 0 (i.e. it is a RUP clause and
+// can safely be written in a DRUP proof).
+
+bool Solver::implied(const vec<Lit>& c) {
+    assert(decisionLevel() == 0);
+
+    trail_lim.push(trail.size());
+    for (int i = 0; i < c.size(); i++)
+        if (value(c[i]) == l_True){
+            cancelUntil(0);
+            return false;
+        }else if (value(c[i]) != l_False){
+            assert(value(c[i]) == l_Undef);
+            uncheckedEnqueue(~c[i]);
+        }
+
+    bool result = propagate() != CRef_Undef;
+    cancelUntil(0);
+    return result;
+}
+
 /************************************************************
  * Compute LBD functions
  *************************************************************/
@@ -607,6 +832,14 @@ void Solver::minimisationWithBinaryResolution(vec<Lit> &out_learnt) {
 
 void Solver::cancelUntil(int level) {
     if (decisionLevel() > level) {
+        // Take back the weights the pseudo-Boolean constraints counted on these levels
+        for (int c = pbHead - 1; c >= trail_lim[level]; c--)
+            if (toInt(trail[c]) < pbOccs.size()) {
+                const vec<PbOcc>& occs = pbOccs[toInt(trail[c])];
+                for (int i = 0; i < occs.size(); i++) pbs[occs[i].pb].sum -= occs[i].weight;
+            }
+        if (pbHead > trail_lim[level]) pbHead = trail_lim[level];
+
         for (int c = trail.size() - 1; c >= trail_lim[level]; c--) {
             Var x = var(trail[c]);
             assigns [x] = l_Undef;
@@ -665,6 +898,7 @@ Lit Solver::pickBranchLit() {
 |  
 |________________________________________________________________________________________________@*/
 void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& out_btlevel,unsigned int &lbd,unsigned int &szWithoutSelectors) {
+    PhaseScope phase(*this, phaseAnalyze);
     int pathC = 0;
     Lit p = lit_Undef;
 
@@ -938,6 +1172,96 @@ void Solver::uncheckedEnqueue(Lit p, CRef from) {
 |      * the propagation queue is empty, even if there was a conflict.
 |________________________________________________________________________________________________@*/
 CRef Solver::propagate() {
+    PhaseScope phase(*this, phasePropagate);
+    CRef confl = propagateClauses();
+    while (confl == CRef_Undef && pbs.size() > 0 && pbHead < trail.size())
+        if ((confl = propagatePb()) == CRef_Undef)
+            confl = propagateClauses();
+    return confl;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  propagatePb : [void]  ->  [CRef]
+|
+|  Description:
+|    Counts the weights of the literals of the trail from 'pbHead' in the sums of the pseudo-Boolean
+|    constraints. A constraint whose sum exceeds its bound is in conflict; otherwise the terms
+|    heavier than its slack (bound - sum) are false. The reasons and the conflicts are clauses,
+|    allocated on the fly: the implied literal (first) and the negation of true terms weighing more
+|    than the bound without it, the heaviest first. They are not attached and are freed once they
+|    are no longer reasons (see 'purgePbReasons'), so analyze and the garbage collection see them as
+|    any other reason.
+|
+|    As the literals are counted in trail order, the literal whose weight makes a sum exceed its
+|    bound is on the current level, and is put in the conflict clause.
+|________________________________________________________________________________________________@*/
+CRef Solver::propagatePb() {
+    if (pbReasons.size() >= pbPurgeAt) purgePbReasons();
+
+    while (pbHead < trail.size()) {
+        Lit p = trail[pbHead++];
+        if (toInt(p) >= pbOccs.size()) continue;
+        const vec<PbOcc>& occs = pbOccs[toInt(p)];
+        for (int i = 0; i < occs.size(); i++) pbs[occs[i].pb].sum += occs[i].weight;
+
+        for (int i = 0; i < occs.size(); i++) {
+            const PbConstraint& c = pbs[occs[i].pb];
+            int64_t slack = c.bound - c.sum;
+            if (slack >= pbWeights[c.first]) continue;       // The heaviest term still fits.
+
+            int at = -1;
+            pb_true.clear();
+            for (int k = c.first; k < c.first + c.size; k++)
+                if (value(pbLits[k]) == l_True) {
+                    pb_true.push(k);
+                    if (pbLits[k] == p) at = k;
+                }
+            if (slack < 0) {
+                nbPbConflicts++;
+                return explainPb(at, c.bound, lit_Undef);
+            }
+            for (int k = c.first; k < c.first + c.size && pbWeights[k] > slack; k++)
+                if (value(pbLits[k]) == l_Undef) {
+                    nbPbPropagations++;
+                    uncheckedEnqueue(~pbLits[k], explainPb(-1, c.bound - pbWeights[k], ~pbLits[k]));
+                }
+        }
+    }
+    return CRef_Undef;
+}
+
+
+CRef Solver::explainPb(int first, int64_t need, Lit implied) {
+    int64_t weight = 0;
+    pb_tmp.clear();
+    if (implied != lit_Undef) pb_tmp.push(implied);
+    if (first >= 0) pb_tmp.push(~pbLits[first]), weight = pbWeights[first];
+    for (int i = 0; i < pb_true.size() && weight <= need; i++)
+        if (pb_true[i] != first)
+            pb_tmp.push(~pbLits[pb_true[i]]), weight += pbWeights[pb_true[i]];
+    assert(weight > need);
+
+    CRef cr = ca.alloc(pb_tmp, false);
+    pbReasons.push(cr);
+    return cr;
+}
+
+
+void Solver::purgePbReasons() {
+    int i, j;
+    for (i = j = 0; i < pbReasons.size(); i++)
+        if (locked(ca[pbReasons[i]]))
+            pbReasons[j++] = pbReasons[i];
+        else
+            ca.free(pbReasons[i]);
+    pbReasons.shrink(i - j);
+    pbPurgeAt = 2 * pbReasons.size() > 1024 ? 2 * pbReasons.size() : 1024;
+}
+
+
+CRef Solver::propagateClauses() {
     CRef confl = CRef_Undef;
     int num_props = 0;
     int previousqhead = qhead;
@@ -1160,6 +1484,8 @@ NextClauseUnary:
 
 void Solver::reduceDB()
 {
+  PhaseScope phase(*this, phaseReduceDB);
+  updateMemoryAccount();
  
   int     i, j;
   nbReduceDB++;
@@ -1232,6 +1558,7 @@ void Solver::rebuildOrderHeap() {
 |________________________________________________________________________________________________@*/
 bool Solver::simplify() {
     assert(decisionLevel() == 0);
+    PhaseScope phase(*this, phaseSimplify);
 
     if (!ok) return ok = false;
     else {
@@ -1281,12 +1608,14 @@ lbool Solver::search(int nof_conflicts) {
     unsigned int nblevels,szWithoutSelectors = 0;
     bool blocked = false;
     starts++;
+    if (histWindow > 0 && histograms && starts % histWindow == 0) reportHistogramWindow();
 
     //adding counter to the number of starts
     restarts.emplace_back(std::make_tuple(starts,cpuTime()));
     
     for (;;) {
         if (decisionLevel() == 0) { // We import clauses FIXME: ensure that we will import clauses enventually (restart after some point)
+            PhaseScope phase(*this, phaseImport);
             parallelImportUnaryClauses();
             
             if (parallelImportClauses())
@@ -1309,6 +1638,7 @@ lbool Solver::search(int nof_conflicts) {
            if (conflicts % 5000 == 0 && var_decay < max_var_decay)
                 var_decay += 0.01;
 
+            if (snapshotOnRequest && snapshotsSeen != snapshotRequests) answerSnapshot();
             if (verbosity >= 1 && conflicts % verbEveryConflicts == 0) {
                 printf("c | %8d   %7d    %5d | %7d %8d %8d | %5d %8d   %6d %8d | %6.3f %% |\n",
                         (int) starts, (int) nbstopsrestarts, (int) (conflicts / starts),
@@ -1340,9 +1670,19 @@ lbool Solver::search(int nof_conflicts) {
 
             lbdQueue.push(nblevels);
             sumLBD += nblevels;
+            if (histograms) {
+                int backjump = decisionLevel() - backtrack_level;
+                hist.lbd     .push(nblevels);             histWin.lbd     .push(nblevels);
+                hist.size    .push(learnt_clause.size()); histWin.size    .push(learnt_clause.size());
+                hist.backjump.push(backjump);             histWin.backjump.push(backjump);
+                hist.trail   .push(trail.size());         histWin.trail   .push(trail.size());
+            }
 
             cancelUntil(backtrack_level);
 
+            if (learntLog != NULL && (learnt_clause.size() <= 2 || nblevels <= learntLogLBD))
+                learntLog->add(learnt_clause, nblevels);
+
             if (certifiedUNSAT) {
                 for (int i = 0; i < learnt_clause.size(); i++)
                     fprintf(certifiedOutput, "%i ", (var(learnt_clause[i]) + 1) *
@@ -1363,6 +1703,8 @@ lbool Solver::search(int nof_conflicts) {
                 if (nblevels <= 2) nbDL2++; // stats
                 if (ca[cr].size() == 2) nbBin++; // stats
                 learnts.push(cr);
+                if (bddStrengthen && !incremental && ca[cr].size() >= bddStrengthenMinSize && nblevels <= bddStrengthenMaxLBD)
+                    bdd_strengthen_queue.push(cr);
 
                 // -------------------------------------------
                 //for (int i=0; i<learnt_clause.size(); i++) {
@@ -1384,7 +1726,8 @@ lbool Solver::search(int nof_conflicts) {
 
         } else {
             // Our dynamic restart, see the SAT09 competition compagnion paper 
-            if ((lbdQueue.isvalid() && ((lbdQueue.getavg() * K) > (sumLBD / conflictsRestarts)))) {
+            // (or the end of the budget, so that short budgets are not overrun by a whole restart)
+            if ((lbdQueue.isvalid() && ((lbdQueue.getavg() * K) > (sumLBD / conflictsRestarts))) || !withinBudget()) {
                 lbdQueue.fastclear();
                 progress_estimate = progressEstimate();
                 int bt = 0;
@@ -1408,6 +1751,12 @@ lbool Solver::search(int nof_conflicts) {
                     if (!panicModeIsEnabled())
                         nbclausesbeforereduce += incReduceDB;
                 }
+            } else if (learnts.size() > 0 && arenaOverBudget() && conflicts >= lastArenaReduction + incReduceDB) {
+                // The clause arena exceeds its share of the memory budget: reduce now, without
+                // moving the schedule of the regular reductions
+                lastArenaReduction = conflicts;
+                nbArenaReductions++;
+                reduceDB();
             }
 
             lastLearntClause = CRef_Undef;
@@ -1460,6 +1809,8 @@ void Solver::translateLearntClauses(std::vector<int> learnt_clauses) {
         if (lit == 0) {
             // If 0 is encountered, finalize the current clause and start a new one
             if (tmp_clause.size() > 0) {
+                nbBddClauses++;
+                if (histograms) hist.bddLemma.push(tmp_clause.size()), histWin.bddLemma.push(tmp_clause.size());
                 addLearntClause(tmp_clause);
                 tmp_clause.clear();
                 printf("Wrote clause %d in BDD clauses.\n", i);
@@ -1489,6 +1840,142 @@ bool Solver::addLearntClause(vec<Lit>& learnt_clause) {
     return true;
 }
 
+/*_________________________________________________________________________________________________
+|
+|  addLearntClause : (learnt_clause : vec<Lit>&) (cr : CRef)  ->  [bool]
+|  
+|  Description:
+|    Replace the learnt clause 'cr' in place by 'learnt_clause', a shorter sub-clause implied by
+|    the formula (computed by the BDD side). Must be called at level 0. Returns FALSE if the
+|    solver became inconsistent.
+|  
+|    With certified UNSAT, the sub-clause is only accepted if it is RUP, so that the proof stays
+|    checkable: the new clause is written first, then the deletion of the old one. The BDD side
+|    gives no derivation, and most of its sub-clauses are not RUP: with certified UNSAT this
+|    strengthening rarely applies.
+|________________________________________________________________________________________________@*/
+bool Solver::addLearntClause(vec<Lit>& learnt_clause, CRef cr) {
+    assert(decisionLevel() == 0);
+    Clause& c = ca[cr];
+    if (c.mark() == 1 || locked(c) || learnt_clause.size() >= c.size())
+        return true;
+
+    // Only a sub-clause can replace the clause in place
+    int i, j;
+    for (i = 0; i < c.size(); i++) seen[var(c[i])] = 1 + sign(c[i]);
+    for (i = 0; i < learnt_clause.size() && seen[var(learnt_clause[i])] == 1 + sign(learnt_clause[i]); i++);
+    bool subClause = i == learnt_clause.size();
+    for (i = 0; i < c.size(); i++) seen[var(c[i])] = 0;
+    if (!subClause)
+        return true;
+
+    // Remove false literals, keep the clause if it is already satisfied
+    for (i = j = 0; i < learnt_clause.size(); i++)
+        if (value(learnt_clause[i]) == l_True)
+            return true;
+        else if (value(learnt_clause[i]) != l_False)
+            learnt_clause[j++] = learnt_clause[i];
+    learnt_clause.shrink(i - j);
+
+    if (certifiedUNSAT) {
+        if (learnt_clause.size() > 0 && !implied(learnt_clause))
+            return true;
+        for (i = 0; i < learnt_clause.size(); i++)
+            fprintf(certifiedOutput, "%i ", (var(learnt_clause[i]) + 1) * (-2 * sign(learnt_clause[i]) + 1));
+        fprintf(certifiedOutput, "0\n");
+    }
+
+    nbBddStrengthened++;
+    nbBddStrengthenedLits += c.size() - learnt_clause.size();
+    if (histograms) hist.bddLemma.push(learnt_clause.size()), histWin.bddLemma.push(learnt_clause.size());
+
+    if (learnt_clause.size() == 0)
+        return ok = false;
+    else if (learnt_clause.size() == 1) {
+        // The old clause is now satisfied and will be removed by simplify()
+        uncheckedEnqueue(learnt_clause[0]);
+        nbUn++;
+        return ok = (propagate() == CRef_Undef);
+    }
+
+    if (certifiedUNSAT) {
+        fprintf(certifiedOutput, "d ");
+        for (i = 0; i < c.size(); i++)
+            fprintf(certifiedOutput, "%i ", (var(c[i]) + 1) * (-2 * sign(c[i]) + 1));
+        fprintf(certifiedOutput, "0\n");
+    }
+
+    detachClause(cr, true);
+    for (i = 0; i < learnt_clause.size(); i++)
+        c[i] = learnt_clause[i];
+    c.shrink(c.size() - learnt_clause.size());
+    if ((int)c.lbd() > c.size()) c.setLBD(c.size());
+    c.setSizeWithoutSelectors(c.size());
+    if (c.size() == 2) nbBin++; // stats
+    attachClause(cr);
+    return true;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  strengthenLearntsWithBDD : (rust_lib : void*) (bdd_var_ordering : BddVarOrdering*)
+|                             (bdd_buckets : BddBuckets*)  ->  [bool]
+|  
+|  Description:
+|    Send the queued learnt clauses to the BDD side which returns, for each of them, a shorter
+|    implied sub-clause (or an empty one if the variables of the clause fall into more than
+|    'bddStrengthenMaxBuckets' buckets or nothing was found). Clauses are exchanged in the same
+|    0-terminated format as the clauses received from 'run'. Returns FALSE if the solver became
+|    inconsistent.
+|________________________________________________________________________________________________@*/
+bool Solver::strengthenLearntsWithBDD(void* rust_lib, BddVarOrdering* bdd_var_ordering, BddBuckets* bdd_buckets) {
+    if (bdd_strengthen_queue.size() == 0 || decisionLevel() > 0)
+        return true;
+
+    typedef std::pair<const int*, size_t> (*RustStrengthen)(BddVarOrdering*, BddBuckets*, const int*, size_t, size_t);
+    RustStrengthen rust_strengthen = reinterpret_cast<RustStrengthen>(dlsym(rust_lib, "strengthen_clauses"));
+    if (!rust_strengthen) {
+        std::cerr << "Error loading Rust function: " << dlerror() << ", BDD strengthening is turned off" << std::endl;
+        bddStrengthen = false;
+        bdd_strengthen_queue.clear(true);
+        return true;
+    }
+
+    std::vector<int> candidates;
+    vec<CRef> sent;
+    for (int i = 0; i < bdd_strengthen_queue.size(); i++) {
+        Clause& c = ca[bdd_strengthen_queue[i]];
+        if (c.mark() == 1) continue; // removed by reduceDB
+        for (int j = 0; j < c.size(); j++)
+            candidates.push_back((var(c[j]) + 1) * (-2 * sign(c[j]) + 1));
+        candidates.push_back(0);
+        sent.push(bdd_strengthen_queue[i]);
+    }
+    bdd_strengthen_queue.clear();
+    if (sent.size() == 0)
+        return true;
+
+    auto rust_data = rust_strengthen(bdd_var_ordering, bdd_buckets, candidates.data(), candidates.size(), bddStrengthenMaxBuckets);
+    const int* vector_data = std::get<0>(rust_data);
+    size_t vec_length = std::get<1>(rust_data);
+    if (!vector_data)
+        return true;
+
+    vec<Lit> sub_clause;
+    int index = 0;
+    for (size_t i = 0; i < vec_length && index < sent.size(); i++) {
+        int lit = vector_data[i];
+        if (lit == 0) {
+            if (sub_clause.size() > 0 && !addLearntClause(sub_clause, sent[index]))
+                return false;
+            sub_clause.clear();
+            index++;
+        } else
+            sub_clause.push((lit > 0) ? mkLit(lit - 1) : ~mkLit(-lit - 1));
+    }
+    return true;
+}
+
 // Load the Rust library
 void* Solver::loadRustLibrary() {
     void* rust_lib = dlopen("/home/lkondylidou/Desktop/PhD/CDCL-support-by-BDD-methods/target/release/librust_lib.so", RTLD_LAZY); // Update the path accordingly
@@ -1504,12 +1991,160 @@ void Solver::unloadRustLibrary(void* rust_lib) {
     dlclose(rust_lib);
 }
 
+// The orderings live in the Rust library: the handle used to build them stays open until the
+// process ends, whatever the solvers load and unload in the meantime. The Rust side opens the file
+// itself and reads it as DIMACS text, so only plain DIMACS files get an ordering: binary CNF, OPB
+// and compressed inputs, and the standard input, get NULL (the search runs without the BDD side).
+BddVarOrdering* Solver::initBddOrdering(const char* file) {
+    if (file == NULL || strcmp(file, "-") == 0 || isOpbFile(file) || isBinaryCnf(file)
+     || InputStream::detect(file) != InputStream::Plain)
+        return NULL;
+    static void* rust_lib = loadRustLibrary();
+    if (!rust_lib) return NULL;
+    auto rust_init = reinterpret_cast<BddVarOrdering*(*)(const char*)>(dlsym(rust_lib, "init"));
+    if (!rust_init) {
+        std::cerr << "Error loading Rust function: " << dlerror() << std::endl;
+        return NULL;
+    }
+    BddVarOrdering* bdd_var_ordering = rust_init(file);
+    if (!bdd_var_ordering)
+        std::cerr << "Failed to create BddVarOrdering in Rust" << std::endl;
+    return bdd_var_ordering;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  acquireBddState : (bdd_var_ordering : BddVarOrdering*)  ->  [bool]
+|
+|  Description:
+|    Make 'bddLib', 'bddBuckets' and 'bddClauseDb' hold the state of the BDD side for the given
+|    ordering. The state built by an earlier call for the same ordering is kept; the one of another
+|    ordering is released first. Returns FALSE (with a message) if the library cannot be used.
+|________________________________________________________________________________________________@*/
+bool Solver::acquireBddState(BddVarOrdering* bdd_var_ordering)
+{
+    if (bddLib != NULL && bddStateOrdering == bdd_var_ordering) return true;
+    releaseBddState();
+
+    // Load the Rust library
+    bddLib = loadRustLibrary();
+    if (bddLib == NULL) return false;
+
+    // Get a pointer to the Rust functions
+    auto create_bdd_buckets = reinterpret_cast<BddBuckets*(*)(BddVarOrdering*)>(dlsym(bddLib, "create_buckets"));
+    auto initialize_bdd_clause_database = reinterpret_cast<BddClauseDatabase*(*)()>(dlsym(bddLib, "initialize_clause_database"));
+
+    if (!create_bdd_buckets || !initialize_bdd_clause_database || !dlsym(bddLib, "run")) {
+        std::cerr << "Error loading Rust function: " << dlerror() << std::endl;
+        releaseBddState();
+        return false;
+    }
+
+    // Create the initial buckets
+    bddBuckets = create_bdd_buckets(bdd_var_ordering);
+    // Create the shared clause database in Rust
+    bddClauseDb = initialize_bdd_clause_database();
+    bddStateOrdering = bdd_var_ordering;
+    return true;
+}
+
+
+// Free the buckets and the clause database through the optional entry points of the library (an
+// older library without them leaks them, once per solver and ordering), and unload it.
+void Solver::releaseBddState()
+{
+    if (bddLib == NULL) return;
+    auto free_buckets = reinterpret_cast<void(*)(BddBuckets*)>(dlsym(bddLib, "free_buckets"));
+    auto free_clause_database = reinterpret_cast<void(*)(BddClauseDatabase*)>(dlsym(bddLib, "free_clause_database"));
+    if (bddBuckets != NULL && free_buckets) free_buckets(bddBuckets);
+    if (bddClauseDb != NULL && free_clause_database) free_clause_database(bddClauseDb);
+    unloadRustLibrary(bddLib);
+    bddLib           = NULL;
+    bddStateOrdering = NULL;
+    bddBuckets       = NULL;
+    bddClauseDb      = NULL;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  setMemoryBudget : (bytes : uint64_t)  ->  [void]
+|
+|  Description:
+|    Split a memory budget between the BDD side ('bddMemFrac' of it, turned into a number of
+|    nodes) and the clause arena. Both sides react before the process hits its hard limit: the
+|    BDD side is shrunk or paused (see 'bddWithinBudget'), the clause database is reduced.
+|________________________________________________________________________________________________@*/
+void Solver::setMemoryBudget(uint64_t bytes)
+{
+    uint64_t bdd = (uint64_t)(bytes * bddMemFrac);
+    arenaMemBudget = bytes - bdd;
+    bddNodeBudget = std::max<uint64_t>(bdd / bddNodeBytes, 1);
+}
+
+
+bool Solver::arenaOverBudget() const
+{
+    return arenaMemBudget > 0 && (uint64_t)ca.size() * sizeof(uint32_t) > arenaMemBudget;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  bddWithinBudget : (rust_lib : void*) (bdd_buckets : BddBuckets*)  ->  [bool]
+|
+|  Description:
+|    Called once per restart. If the BDD side uses more nodes than its budget, its buckets are
+|    first shrunk back to 3/4 of the budget. If it is still over budget (or can not be shrunk),
+|    it is paused for 'bddPauseLength' restarts, and the next pause is twice as long. The usage
+|    and shrinking entry points are optional: without them, only the budget given to the BDD
+|    side at creation applies.
+|________________________________________________________________________________________________@*/
+bool Solver::bddWithinBudget(void* rust_lib, BddBuckets* bdd_buckets)
+{
+    if (bddNodeBudget == 0) return true;
+    if (starts < bddPausedUntil) return false;
+
+    auto bdd_nodes_in_use = reinterpret_cast<size_t(*)(BddBuckets*)>(dlsym(rust_lib, "bdd_nodes_in_use"));
+    if (!bdd_nodes_in_use) return true;
+    uint64_t used = bdd_nodes_in_use(bdd_buckets);
+    if (used > bddPeakNodes) bddPeakNodes = used;
+    if (used <= bddNodeBudget) return true;
+
+    auto shrink_buckets = reinterpret_cast<size_t(*)(BddBuckets*, size_t)>(dlsym(rust_lib, "shrink_buckets"));
+    if (shrink_buckets) {
+        nbBddShrinks++;
+        used = shrink_buckets(bdd_buckets, bddNodeBudget / 4 * 3);
+        if (used <= bddNodeBudget) return true;
+    }
+
+    nbBddPauses++;
+    bddPausedUntil = starts + bddPauseLength;
+    if (verbosity >= 1)
+        printf("c BDD side over its node budget (%" PRIu64" > %" PRIu64" nodes), paused for %d restarts\n", used, bddNodeBudget, bddPauseLength);
+    bddPauseLength = bddPauseLength > INT32_MAX / 2 ? INT32_MAX : 2 * bddPauseLength;
+    return false;
+}
+
 /************************************************************************************/
 /****************************Danail**************************************************/
 /************************************************************************************/
 
 
 // Writes learnt clause from the BDD vector to the learnt clauses vector
+void Solver::openPerfCounters()
+{
+    if (!perfCounters || perf != NULL) return;
+    perf = new PerfCounters();
+    if (!perf->open()) {
+        delete perf;
+        perf = NULL;
+        perfCounters = false;
+    }
+}
+
+
 void Solver::writeLearntClause(CRef cr){
     learnts.push(cr);
     attachClause(cr);
@@ -1562,6 +2197,9 @@ void Solver::printIncrementalStats() {
     printf("c conflicts             : %" PRIu64"\n", conflicts);
     printf("c decisions             : %" PRIu64"\n", decisions);
     printf("c propagations          : %" PRIu64"\n", propagations);
+    if (timePhases) phaseTimer.printStats();
+    if (accountMemory) memAccount.printStats();
+    if (histograms && hist.lbd.count() > 0) printf("c distributions         :\n"), hist.print();
 
   printf("\nc SAT Calls             : %d in %g seconds\n",nbSatCalls,totalTime4Sat);
   printf("c UNSAT Calls           : %d in %g seconds\n",nbUnsatCalls,totalTime4Unsat);
@@ -1569,6 +2207,668 @@ void Solver::printIncrementalStats() {
     printf("c--------------------------------------------------\n");
 }
 
+void Solver::writeStats(JsonWriter& json) const {
+    json.value("vars", nVars());
+    json.value("clauses", nClauses());
+    json.value("learnts", nLearnts());
+    json.value("solves", solves);
+    json.value("restarts", starts);
+    json.value("blocked_restarts", nbstopsrestarts);
+    json.value("conflicts", conflicts);
+    json.value("decisions", decisions);
+    json.value("random_decisions", rnd_decisions);
+    json.value("propagations", propagations);
+    json.value("conflict_literals", tot_literals);
+    json.value("conflict_literals_before_min", max_literals);
+    json.value("reduce_db", nbReduceDB);
+    json.value("removed_clauses", nbRemovedClauses);
+    json.value("reduced_clauses", nbReducedClauses);
+    json.value("learnts_dl2", nbDL2);
+    json.value("learnts_size2", nbBin);
+    json.value("learnts_size1", nbUn);
+    json.value("promoted", nbPromoted);
+    if (pbs.size() > 0) {
+        json.value("pb_constraints", pbs.size());
+        json.value("pb_propagations", nbPbPropagations);
+        json.value("pb_conflicts", nbPbConflicts);
+    }
+    if (timePhases) phaseTimer.writeJson(json, "phases");
+    if (accountMemory) memAccount.writeJson(json, "structures");
+    if (histograms) hist.writeJson(json, "histograms");
+
+    json.beginObject("bdd");
+    json.value("runs", nbBddRuns);
+    json.value("lits_sent", nbBddLitsSent);
+    json.value("clauses_received", nbBddClauses);
+    json.value("time", bddTime);
+    json.value("strengthened", nbBddStrengthened);
+    json.value("strengthened_lits", nbBddStrengthenedLits);
+    json.value("node_budget", bddNodeBudget);
+    json.value("peak_nodes", bddPeakNodes);
+    json.value("shrinks", nbBddShrinks);
+    json.value("pauses", nbBddPauses);
+    json.endObject();
+
+    json.beginObject("arena");
+    json.value("budget_bytes", arenaMemBudget);
+    json.value("forced_reductions", nbArenaReductions);
+    json.endObject();
+}
+
+
+//=================================================================================================
+// Memory accounting:
+
+
+template<class T>
+static uint64_t traceBytes(const std::vector<T>& v) { return (uint64_t)v.capacity() * sizeof(T); }
+
+void Solver::collectMemory(MemoryAccount& acc) const {
+    acc.add("arena_live",    (uint64_t)(ca.size() - ca.wasted()) * ClauseAllocator::Unit_Size);
+    acc.add("arena_wasted",  (uint64_t)ca.wasted() * ClauseAllocator::Unit_Size);
+    acc.add("arena_free",    (uint64_t)(ca.getCap() - ca.size()) * ClauseAllocator::Unit_Size);
+    acc.add("watches",       watches.bytes());
+    acc.add("watches_bin",   watchesBin.bytes());
+    acc.add("unary_watches", unaryWatches.bytes());
+    acc.add("clauses",       clauses.bytes());
+    acc.add("learnts",       learnts.bytes() + unaryWatchedClauses.bytes());
+    if (pbs.size() > 0) {
+        uint64_t pb = pbs.bytes() + pbLits.bytes() + pbWeights.bytes() + pbOccs.bytes() + pbReasons.bytes();
+        for (int i = 0; i < pbOccs.size(); i++) pb += pbOccs[i].bytes();
+        acc.add("pb_constraints", pb);
+    }
+    acc.add("trail",         trail.bytes() + trail_lim.bytes() + assumptions.bytes());
+    acc.add("vardata",       vardata.bytes() + assigns.bytes() + polarity.bytes() + decision.bytes() + activity.bytes()
+                             + order_heap.bytes() + permDiff.bytes() + nbpos.bytes() + seen.bytes());
+    acc.add("traces",        traceBytes(restarts) + traceBytes(reducedDatabase) + traceBytes(conf) + traceBytes(propags)
+                             + traceBytes(confLiterals) + traceBytes(dec) + traceBytes(blockedRestarts));
+
+    uint64_t bdd = traceBytes(tmp_learnts) + traceBytes(internal_learnts) + traceBytes(bdd_clauses)
+                 + bdd_strengthen_queue.bytes() + traceBytes(bddClauses) + traceBytes(refs);
+    for (size_t i = 0; i < bddClauses.size(); i++) bdd += bddClauses[i].bytes();
+    acc.add("bdd_buffers", bdd);
+}
+
+
+void Solver::updateMemoryAccount(const ClauseAllocator* gcCopy) {
+    if (!accountMemory) return;
+    memAccount.begin();
+    collectMemory(memAccount);
+    if (gcCopy != NULL) memAccount.add("arena_gc_copy", (uint64_t)gcCopy->getCap() * ClauseAllocator::Unit_Size);
+    memAccount.end();
+}
+
+// Window reports go to 'histFile' as JSON lines (one per window), or are printed as comment lines.
+void Solver::reportHistogramWindow() {
+    if (histWin.lbd.count() > 0) {
+        FILE* out = histFile != NULL ? fopen(histFile, "a") : NULL;
+        if (histFile != NULL && out == NULL) {
+            printf("c WARNING! Could not open histogram file %s, printing the windows\n", histFile);
+            histFile = NULL;
+        }
+        if (out != NULL) {
+            JsonWriter json(out);
+            json.beginObject();
+            json.value("restarts", starts);
+            json.value("conflicts", conflicts);
+            histWin.writeJson(json, "window");
+            json.endObject();
+            fclose(out);
+        } else {
+            printf("c histograms of the restarts %" PRIu64" to %" PRIu64":\n", starts - histWindow, starts - 1);
+            histWin.print();
+        }
+    }
+    histWin.clear();
+}
+
+//=================================================================================================
+// Checkpoints:
+
+
+volatile sig_atomic_t Solver::checkpointRequests = 0;
+
+void Solver::checkpointIfDue() {
+    double now = realTime();
+    if (lastCheckpoint == 0) lastCheckpoint = now;
+    bool requested = checkpointsSeen != checkpointRequests;
+    if (decisionLevel() > 0 || (!requested && (checkpointEvery == 0 || now - lastCheckpoint < checkpointEvery)))
+        return;
+    checkpointsSeen = checkpointRequests;
+    lastCheckpoint = now;
+    if (writeCheckpoint(checkpointFile)) {
+        nbCheckpoints++;
+        if (verbosity >= 1)
+            printf("c checkpoint %" PRIu64" written to %s (%d learnts, %.2f s)\n", nbCheckpoints, checkpointFile, nLearnts(), realTime() - now);
+    }
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  writeCheckpoint : (file : const char*)  ->  [bool]
+|
+|  Description:
+|    Stream the state of the solver at level 0 to 'file': the counters which drive the restarts
+|    and the clause database reductions, the activities and phases of the variables, the level 0
+|    trail, the problem clauses and the learnt clauses with their LBD and activity, then the state
+|    of the subclasses (see 'writeCheckpointExtra'). The saved state is the one after a restart,
+|    the search resumes from there once loaded.
+|________________________________________________________________________________________________@*/
+bool Solver::writeCheckpoint(const char* file)
+{
+    assert(decisionLevel() == 0);
+    if (pbs.size() > 0) {
+        fprintf(stderr, "c WARNING! No checkpoint of a solver with pseudo-Boolean constraints\n");
+        return false;
+    }
+    std::string tmp = std::string(file) + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (f == NULL) {
+        fprintf(stderr, "c WARNING! Could not open checkpoint file %s: %s\n", tmp.c_str(), strerror(errno));
+        return false;
+    }
+    setvbuf(f, NULL, _IOFBF, 1 << 20);
+    CheckpointWriter out(f);
+
+    out.put32(checkpointMagic);
+    out.put32(checkpointVersion);
+    out.put32(checkpointByteOrder);
+    out.putString(checkpointName);
+    out.put32(ok);
+
+    // Counters and schedules:
+    out.put64(starts);          out.put64(conflicts);        out.put64(decisions);
+    out.put64(rnd_decisions);   out.put64(propagations);     out.put64(nbReduceDB);
+    out.put64(nbRemovedClauses);out.put64(nbReducedClauses); out.put64(nbDL2);
+    out.put64(nbBin);           out.put64(nbUn);             out.put64(conflictsRestarts);
+    out.put64(nbstopsrestarts); out.put64(curRestart);       out.put64(nbclausesbeforereduce);
+    out.putDouble(var_inc);     out.putDouble(cla_inc);      out.putDouble(var_decay);
+    out.putDouble(random_seed); out.putDouble(sumLBD);
+
+    // Variables:
+    out.put32(nVars());
+    for (Var v = 0; v < nVars(); v++) out.putDouble(activity[v]);
+    out.bytes((char*)polarity, nVars());
+    out.bytes((char*)decision, nVars());
+
+    // Level 0 trail:
+    out.put32(trail.size());
+    for (int i = 0; i < trail.size(); i++) out.put32(toInt(trail[i]));
+
+    // Problem clauses, then learnt clauses (including the ones received from the BDD side):
+    int n = 0;
+    for (int i = 0; i < clauses.size(); i++) if (ca[clauses[i]].mark() != 1) n++;
+    out.put32(n);
+    for (int i = 0; i < clauses.size(); i++) {
+        Clause& c = ca[clauses[i]];
+        if (c.mark() == 1) continue;
+        out.put32(c.size());
+        for (int j = 0; j < c.size(); j++) out.put32(toInt(c[j]));
+    }
+
+    n = 0;
+    for (int i = 0; i < learnts.size(); i++) if (ca[learnts[i]].mark() != 1) n++;
+    for (size_t i = 0; i < bdd_clauses.size(); i++) if (ca[bdd_clauses[i]].mark() != 1) n++;
+    out.put32(n);
+    for (int i = 0; i < learnts.size() + (int)bdd_clauses.size(); i++) {
+        CRef cr = i < learnts.size() ? learnts[i] : bdd_clauses[i - learnts.size()];
+        Clause& c = ca[cr];
+        if (c.mark() == 1) continue;
+        out.put32(c.size());
+        out.put32(c.lbd() | (c.canBeDel() ? 0 : 0x80000000u));
+        float act = c.activity();
+        out.bytes(&act, sizeof(act));
+        for (int j = 0; j < c.size(); j++) out.put32(toInt(c[j]));
+    }
+
+    writeCheckpointExtra(out);
+    out.put32(checkpointMagic);
+
+    bool written = out.ok() && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    written = fclose(f) == 0 && written;
+    if (!written || rename(tmp.c_str(), file) != 0) {
+        fprintf(stderr, "c WARNING! Could not write checkpoint file %s: %s\n", file, strerror(errno));
+        ::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+
+void Solver::writeCheckpointExtra(CheckpointWriter& out) const {}
+
+bool Solver::readCheckpointExtra(CheckpointReader& in) { return true; }
+
+
+// Read the 'size' literals of a clause, false if the file is corrupted.
+bool Solver::readCheckpointClause(CheckpointReader& in, int size, vec<Lit>& lits)
+{
+    lits.clear();
+    if (size < 0 || size > nVars()) return false;
+    for (int j = 0; j < size; j++) {
+        Lit p = toLit(in.get32());
+        if (p.x < 0 || var(p) >= nVars()) return false;
+        lits.push(p);
+    }
+    return in.ok();
+}
+
+
+bool Solver::restoreLearnt(vec<Lit>& lits, unsigned int lbd, float act, bool canBeDel)
+{
+    // The level 0 trail may have grown since the clause was learnt:
+    int i, j;
+    for (i = j = 0; i < lits.size(); i++) {
+        if (value(lits[i]) == l_True) return true;
+        if (value(lits[i]) != l_False) lits[j++] = lits[i];
+    }
+    lits.shrink(i - j);
+
+    if (lits.size() == 0) return ok = false;
+    if (lits.size() == 1) {
+        uncheckedEnqueue(lits[0]);
+        return ok = (propagate() == CRef_Undef);
+    }
+    CRef cr = ca.alloc(lits, true);
+    ca[cr].setLBD(lbd);
+    ca[cr].setOneWatched(false);
+    ca[cr].setSizeWithoutSelectors(lits.size());
+    ca[cr].activity() = act;
+    ca[cr].setCanBeDel(canBeDel);
+    learnts.push(cr);
+    attachClause(cr);
+    return true;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  loadCheckpoint : (file : const char*)  ->  [bool]
+|
+|  Description:
+|    Restore a state written by 'writeCheckpoint' into an empty solver. If 'checkpointName' is
+|    set, the checkpoint must have been written for the same instance. Returns false (with a
+|    message) if the file can not be used, the solver is unchanged unless the file is corrupted
+|    after the header.
+|________________________________________________________________________________________________@*/
+bool Solver::loadCheckpoint(const char* file)
+{
+    if (nVars() != 0) {
+        fprintf(stderr, "c ERROR! A checkpoint can only be loaded into an empty solver\n");
+        return false;
+    }
+    FILE* f = fopen(file, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "c ERROR! Could not open checkpoint file %s: %s\n", file, strerror(errno));
+        return false;
+    }
+    CheckpointReader in(f);
+
+    if (in.get32() != checkpointMagic || in.get32() != checkpointVersion || in.get32() != checkpointByteOrder) {
+        fprintf(stderr, "c ERROR! %s is not a checkpoint of this version on this architecture\n", file);
+        fclose(f);
+        return false;
+    }
+    std::string name = in.getString();
+    if (checkpointName != NULL && name != checkpointName) {
+        fprintf(stderr, "c ERROR! Checkpoint %s was written for %s, not %s\n", file, name.c_str(), checkpointName);
+        fclose(f);
+        return false;
+    }
+    bool wasOk = in.get32();
+
+    starts           = in.get64(); conflicts        = in.get64(); decisions    = in.get64();
+    rnd_decisions    = in.get64(); propagations     = in.get64(); nbReduceDB   = in.get64();
+    nbRemovedClauses = in.get64(); nbReducedClauses = in.get64(); nbDL2        = in.get64();
+    nbBin            = in.get64(); nbUn             = in.get64(); conflictsRestarts = in.get64();
+    nbstopsrestarts  = in.get64(); curRestart       = in.get64(); nbclausesbeforereduce = in.get64();
+    var_inc          = in.getDouble(); cla_inc      = in.getDouble(); var_decay = in.getDouble();
+    random_seed      = in.getDouble(); sumLBD       = in.getDouble();
+
+    // Each variable takes an activity, a polarity and a decision flag: a corrupted count must not
+    // size the arrays beyond what the file holds.
+    int nv = in.get32();
+    if (!in.ok() || nv < 0 || (uint64_t)nv * (sizeof(double) + 2) > in.remaining()) {
+        fprintf(stderr, "c ERROR! Checkpoint file %s is truncated or corrupted\n", file);
+        fclose(f);
+        return false;
+    }
+    vec<double> act(nv);
+    vec<char>   pol(nv), dec(nv);
+    in.bytes((double*)act, sizeof(double) * nv);
+    in.bytes((char*)pol, nv);
+    in.bytes((char*)dec, nv);
+    for (Var v = 0; v < nv && in.ok(); v++) {
+        newVar(pol[v], dec[v]);
+        activity[v] = act[v];
+    }
+    rebuildOrderHeap();
+
+    vec<Lit> lits;
+    bool valid = in.ok();
+    int n = in.get32();
+    for (int i = 0; i < n && valid && ok; i++) {
+        lits.clear();
+        valid = readCheckpointClause(in, 1, lits);
+        if (valid) addClause_(lits);
+    }
+
+    n = in.get32();
+    for (int i = 0; i < n && valid && ok; i++) {
+        valid = readCheckpointClause(in, in.get32(), lits);
+        if (valid) addClause_(lits);
+    }
+
+    n = in.get32();
+    for (int i = 0; i < n && valid && ok; i++) {
+        int size = in.get32();
+        uint32_t lbd = in.get32();
+        float a;
+        in.bytes(&a, sizeof(a));
+        valid = readCheckpointClause(in, size, lits);
+        if (valid) restoreLearnt(lits, lbd & 0x7fffffffu, a, !(lbd & 0x80000000u));
+    }
+
+    bool done = valid && readCheckpointExtra(in) && in.get32() == checkpointMagic && in.ok();
+    fclose(f);
+    if (!done) {
+        fprintf(stderr, "c ERROR! Checkpoint file %s is truncated or corrupted\n", file);
+        return false;
+    }
+    if (!wasOk) ok = false;
+    if (verbosity >= 1)
+        printf("c restored checkpoint %s: %d variables, %d clauses, %d learnts, %" PRIu64" conflicts\n",
+               file, nVars(), nClauses(), nLearnts(), conflicts);
+    return true;
+}
+
+//=================================================================================================
+// Warm start:
+//
+// A text file, with the variables named by their DIMACS index so that it stays meaningful for an
+// edited instance:
+//
+//   p warm <nb vars>
+//   v <var> <phase (1 = true)> <activity, scaled to [0,1]>
+//   l <lbd> <lits> 0
+//
+// Imported clauses are only added if they are implied by unit propagation on the new formula
+// (see 'implied', which also makes them valid steps of the DRUP proof), the others are hints: the
+// activity of their variables is bumped.
+
+
+bool Solver::writeWarmStart(const char* file)
+{
+    assert(decisionLevel() == 0);
+    FILE* out = fopen(file, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "c WARNING! Could not open warm start file %s: %s\n", file, strerror(errno));
+        return false;
+    }
+
+    double maxAct = 0;
+    for (Var v = 0; v < nVars(); v++) if (activity[v] > maxAct) maxAct = activity[v];
+    if (maxAct == 0) maxAct = 1;
+
+    fprintf(out, "c glucose warm start\np warm %d\n", nVars());
+    for (Var v = 0; v < nVars(); v++)
+        fprintf(out, "v %d %d %.6g\n", v + 1, !polarity[v], activity[v] / maxAct);
+
+    for (int i = 0; i < trail.size(); i++)
+        fprintf(out, "l 1 %d 0\n", (var(trail[i]) + 1) * (-2 * sign(trail[i]) + 1));
+    for (int i = 0; i < learnts.size(); i++) {
+        Clause& c = ca[learnts[i]];
+        if (c.mark() == 1 || c.size() > warmMaxSize || c.lbd() > warmMaxLBD) continue;
+        fprintf(out, "l %u", c.lbd());
+        for (int j = 0; j < c.size(); j++)
+            fprintf(out, " %d", (var(c[j]) + 1) * (-2 * sign(c[j]) + 1));
+        fprintf(out, " 0\n");
+    }
+    return fclose(out) == 0;
+}
+
+
+bool Solver::loadWarmStart(const char* file)
+{
+    assert(decisionLevel() == 0);
+    FILE* in = fopen(file, "rb");
+    if (in == NULL) {
+        fprintf(stderr, "c WARNING! Could not open warm start file %s: %s\n", file, strerror(errno));
+        return false;
+    }
+
+    vec<Lit>  lits;
+    vec<char> phases(nVars(), -1); // Set at the end: checking the clauses overwrites the saved phases.
+    char      kind[2];
+    bool      activities = false;
+    while (ok && fscanf(in, " %1s", kind) == 1) {
+        if (kind[0] == 'v') {
+            int v, phase;
+            double act;
+            if (fscanf(in, "%d %d %lf", &v, &phase, &act) != 3) break;
+            if (v < 1 || v > nVars()) continue;
+            phases[v - 1] = !phase;
+            activity[v - 1] = act * var_inc;
+            activities = true;
+        } else if (kind[0] == 'l') {
+            unsigned int lbd;
+            int lit;
+            bool known = true;
+            if (fscanf(in, "%u", &lbd) != 1) break;
+            lits.clear();
+            while (fscanf(in, "%d", &lit) == 1 && lit != 0) {
+                if (abs(lit) > nVars()) known = false;
+                else lits.push(lit > 0 ? mkLit(lit - 1) : ~mkLit(-lit - 1));
+            }
+            for (int i = 0; i < lits.size() && known; i++)
+                if (value(lits[i]) == l_True) known = false; // Already satisfied
+            if (!known || lits.size() == 0) continue;
+            if (implied(lits)) {
+                nbWarmClauses++;
+                if (certifiedUNSAT) {
+                    // Implied by unit propagation: a valid step of the DRUP proof
+                    for (int i = 0; i < lits.size(); i++)
+                        fprintf(certifiedOutput, "%i ", (var(lits[i]) + 1) * (-2 * sign(lits[i]) + 1));
+                    fprintf(certifiedOutput, "0\n");
+                }
+                restoreLearnt(lits, lbd, 0, true);
+            } else {
+                nbWarmHints++;
+                for (int i = 0; i < lits.size(); i++) varBumpActivity(var(lits[i]));
+            }
+        } else {
+            // Comments and the header
+            int c;
+            while ((c = fgetc(in)) != EOF && c != '\n');
+        }
+    }
+    fclose(in);
+    for (Var v = 0; v < nVars(); v++)
+        if (phases[v] >= 0) polarity[v] = phases[v];
+    if (activities) rebuildOrderHeap();
+
+    if (verbosity >= 1)
+        printf("c warm start from %s: %" PRIu64" implied clauses, %" PRIu64" hints\n", file, nbWarmClauses, nbWarmHints);
+    return true;
+}
+
+//=================================================================================================
+// Logs of learnt clauses:
+//
+// A run logs the learnt clauses of its search (see LearntLog.h), a later run on the same formula,
+// possibly with other options, imports them before its search. The log records the hash of the
+// formula as it was loaded, so a log is never applied to another formula. The clauses are implied
+// by the formula, so they are imported without any check, except that they must not mention a
+// variable eliminated by this run.
+
+
+// Order independent hash of the clauses and of the level 0 assignments. A permutation of the
+// clauses or of their literals hashes the same, up to the clauses found satisfied while loading.
+uint64_t Solver::problemHash() const
+{
+    SetHash  set;
+    vec<Lit> lits;
+    for (int i = 0; i < clauses.size(); i++) {
+        const Clause& c = ca[clauses[i]];
+        lits.clear();
+        for (int j = 0; j < c.size(); j++) lits.push(c[j]);
+        sort(lits);
+        StreamHash h;
+        for (int j = 0; j < lits.size(); j++) h.update64(toInt(lits[j]));
+        set.add(h.digest());
+    }
+    for (int i = 0; i < trail.size(); i++) {
+        StreamHash h;
+        h.update64(toInt(trail[i]));
+        set.add(h.digest());
+    }
+    for (int i = 0; i < pbs.size(); i++) {
+        SetHash terms;
+        for (int k = pbs[i].first; k < pbs[i].first + pbs[i].size; k++) {
+            StreamHash t;
+            t.update64(toInt(pbLits[k]));
+            t.update64(pbWeights[k]);
+            terms.add(t.digest());
+        }
+        StreamHash h(1);             // Not the hash of a clause
+        h.update64(pbs[i].bound);
+        h.update64(terms.digest());
+        set.add(h.digest());
+    }
+    StreamHash h;
+    h.update64(nVars());
+    h.update64(set.digest());
+    return h.digest();
+}
+
+
+bool Solver::openLearntLog(const char* file, uint64_t problem_hash)
+{
+    closeLearntLog();
+    learntLog = new LearntLog();
+    if (!learntLog->open(file, problem_hash, nVars())) {
+        delete learntLog;
+        learntLog = NULL;
+        return false;
+    }
+    // The units already known are as useful to the next run as the ones learnt.
+    vec<Lit> unit(1);
+    for (int i = 0; i < trail.size(); i++) {
+        unit[0] = trail[i];
+        learntLog->add(unit, 1);
+    }
+    return true;
+}
+
+
+bool Solver::closeLearntLog()
+{
+    if (learntLog == NULL) return true;
+    bool ok = learntLog->close();
+    if (verbosity >= 1)
+        printf("c learnt clause log: %" PRIu64" clauses in %" PRIu64" bytes, %" PRIu64" dropped\n",
+               learntLog->nbClauses, learntLog->nbBytes, learntLog->nbDropped);
+    delete learntLog;
+    learntLog = NULL;
+    return ok;
+}
+
+
+bool Solver::loadLearntLog(const char* file, uint64_t problem_hash)
+{
+    assert(decisionLevel() == 0);
+    LearntLogReader in;
+    if (!in.open(file, problem_hash)) return false;
+    if (in.nbVars != nVars()) {
+        fprintf(stderr, "c WARNING! %s was written for %d variables instead of %d, it is ignored\n", file, in.nbVars, nVars());
+        return false;
+    }
+
+    vec<Lit>     lits;
+    unsigned int lbd;
+    uint64_t     skipped = 0;
+    while (ok && in.next(lits, lbd)) {
+        bool importable = lits.size() > 0;
+        for (int i = 0; i < lits.size() && importable; i++)
+            importable = canImport(var(lits[i]));
+        if (!importable) { skipped++; continue; }
+        nbSeededClauses++;
+        restoreLearnt(lits, lbd, 0, lits.size() > 2 && lbd > 2);
+    }
+    if (ok) ok = propagate() == CRef_Undef;
+
+    if (verbosity >= 1)
+        printf("c seeded from %s: %" PRIu64" clauses, %" PRIu64" skipped (eliminated variables)\n", file, nbSeededClauses, skipped);
+    return true;
+}
+
+//=================================================================================================
+// Snapshots of a running search:
+
+
+volatile sig_atomic_t Solver::snapshotRequests = 0;
+
+void Solver::writeSnapshot(JsonWriter& json) {
+    updateMemoryAccount();
+    json.value("memory_mb", memUsed());
+    json.value("cpu_time", cpuTime());
+    json.value("decision_level", decisionLevel());
+    json.value("trail", trail.size());
+    json.value("level0_assigned", trail_lim.size() == 0 ? trail.size() : trail_lim[0]);
+    writeStats(json);
+
+    // Learnt clauses per tier: glue clauses are never removed, protected ones survive the next
+    // reduceDB, the others compete on their activity.
+    int glue = 0, prot = 0, local = 0;
+    for (int i = 0; i < learnts.size(); i++) {
+        Clause& c = ca[learnts[i]];
+        if (c.lbd() <= 2) glue++;
+        else if (!c.canBeDel()) prot++;
+        else local++;
+    }
+    json.beginObject("tiers");
+    json.value("glue", glue);
+    json.value("protected", prot);
+    json.value("local", local);
+    json.value("literals", learnts_literals);
+    json.endObject();
+
+    json.beginObject("bdd_queues");
+    json.value("strengthen", bdd_strengthen_queue.size());
+    json.value("received_lits", (uint64_t)tmp_learnts.size());
+    json.value("paused", (uint64_t)starts < bddPausedUntil);
+    json.endObject();
+
+    json.beginObject("arena_mem");
+    json.value("bytes", (uint64_t)ca.size() * ClauseAllocator::Unit_Size);
+    json.value("wasted_bytes", (uint64_t)ca.wasted() * ClauseAllocator::Unit_Size);
+    json.endObject();
+}
+
+
+// Write one JSON line per snapshot. Solvers of several threads may answer the same request, the
+// lines are kept whole by a lock.
+void Solver::answerSnapshot() {
+    static std::mutex snapshotLock;
+    snapshotsSeen = snapshotRequests;
+
+    std::lock_guard<std::mutex> lock(snapshotLock);
+    FILE* out = snapshotFile != NULL ? fopen(snapshotFile, "a") : stderr;
+    if (out == NULL) {
+        fprintf(stderr, "c WARNING! Could not open snapshot file %s, writing to stderr\n", snapshotFile);
+        snapshotFile = NULL;
+        out = stderr;
+    }
+    JsonWriter json(out);
+    json.beginObject();
+    json.value("snapshot", (int)snapshotsSeen);
+    writeSnapshot(json);
+    json.endObject();
+    json.flush();
+    if (out != stderr) fclose(out);
+}
+
 // NOTE: assumptions passed in member-variable 'assumptions'.
 
 lbool Solver::solve_(BddVarOrdering* bdd_var_ordering, bool do_simp, bool turn_off_simp) // Parameters are useless in core but useful for SimpSolver....
@@ -1577,31 +2877,34 @@ lbool Solver::solve_(BddVarOrdering* bdd_var_ordering, bool do_simp, bool turn_o
     printf("Can not use incremental and certified unsat in the same time\n");
     exit(-1);
   }
-    // Load the Rust library
-    void* rust_lib = loadRustLibrary();
-
-    // Get a pointer to the Rust functions
-    auto create_bdd_buckets = reinterpret_cast<BddBuckets*(*)(BddVarOrdering*)>(dlsym(rust_lib, "create_buckets"));
-    auto initialize_bdd_clause_database = reinterpret_cast<BddClauseDatabase*(*)()>(dlsym(rust_lib, "initialize_clause_database"));
-    
     typedef std::pair<const int*, size_t> (*RustTouple)(BddVarOrdering*, BddBuckets*, BddClauseDatabase*, int*, size_t);;
-    RustTouple rust_run = reinterpret_cast<RustTouple>(dlsym(rust_lib, "run"));
-
-    if (!create_bdd_buckets || !initialize_bdd_clause_database || !rust_run) {
-        std::cerr << "Error loading Rust function: " << dlerror() << std::endl;
-        dlclose(rust_lib);
-        return l_False;
+    void*              rust_lib            = NULL;
+    RustTouple         rust_run            = NULL;
+    BddBuckets*        bdd_buckets         = NULL;
+    BddClauseDatabase* bdd_clause_database = NULL;
+
+    // Without a variable ordering (none given, or the BDD side could not build one) the search runs
+    // alone: the BDD side is neither loaded nor called. With one, the buckets and the clause database
+    // built by an earlier call for the same ordering are reused (a time sliced or incremental run
+    // calls this again and again).
+    if (bdd_var_ordering != NULL) {
+        if (!acquireBddState(bdd_var_ordering)) return l_False;
+        rust_lib            = bddLib;
+        rust_run            = reinterpret_cast<RustTouple>(dlsym(rust_lib, "run"));
+        bdd_buckets         = bddBuckets;
+        bdd_clause_database = bddClauseDb;
+        // Tell the BDD side its node budget (optional entry point)
+        auto set_node_budget = reinterpret_cast<void(*)(BddBuckets*, size_t)>(dlsym(rust_lib, "set_node_budget"));
+        if (bddNodeBudget > 0 && set_node_budget)
+            set_node_budget(bdd_buckets, bddNodeBudget);
     }
 
-    // Create the initial buckets
-    BddBuckets* bdd_buckets = create_bdd_buckets(bdd_var_ordering);
-    // Create the shared clause database in Rust
-    BddClauseDatabase* bdd_clause_database = initialize_bdd_clause_database();
-
 
     model.clear();
     conflict.clear();
     if (!ok) return l_False;
+    openPerfCounters();
+    PhaseScope searchPhase(*this, phaseSearch);
     double curTime = cpuTime();
     solves++;
     
@@ -1628,12 +2931,14 @@ lbool Solver::solve_(BddVarOrdering* bdd_var_ordering, bool do_simp, bool turn_o
       printf("c =========================================================================================================\n");
     }
 
-    // add a test clause
-    internal_learnts.push_back(8);
-    internal_learnts.push_back(3);
-    internal_learnts.push_back(35);
-    internal_learnts.push_back(35);
-    internal_learnts.push_back(0);
+    // add a test clause (once: the later calls reuse it)
+    if (internal_learnts.empty()) {
+        internal_learnts.push_back(8);
+        internal_learnts.push_back(3);
+        internal_learnts.push_back(35);
+        internal_learnts.push_back(35);
+        internal_learnts.push_back(0);
+    }
     size_t iLearntsSize = internal_learnts.size();
     int* iLearntsPtr = internal_learnts.data();
 
@@ -1644,7 +2949,9 @@ lbool Solver::solve_(BddVarOrdering* bdd_var_ordering, bool do_simp, bool turn_o
         // Do other work in the main thread
         status = search(0); // the parameter is useless in glucose, kept to allow modifications
         if (!withinBudget()) break;
+        if (status == l_Undef && checkpointFile != NULL) checkpointIfDue();
         curr_restarts++;
+        if (bdd_var_ordering == NULL) continue;
 
         // lk
 
@@ -1656,14 +2963,17 @@ lbool Solver::solve_(BddVarOrdering* bdd_var_ordering, bool do_simp, bool turn_o
 
     if (!stop_rust_function || !continue_rust_function) {
         std::cerr << "Error loading Rust function: " << dlerror() << std::endl;
-        dlclose(rust_lib);
+        releaseBddState();
         return l_False;
     }
 
+    PhaseScope bddPhase(*this, phaseBdd); // Up to the end of the restart
+    bool bddAllowed = bddWithinBudget(rust_lib, bdd_buckets);
     if(tmp_learnts.size() > 0) {
         translateLearntClauses(tmp_learnts);
         tmp_learnts.clear();
-    } else {
+    } else if (bddAllowed) {
+        double bddStart = realTime();
         // Call Rust function in a separate thread
         std::thread rust_thread([rust_run, bdd_var_ordering, bdd_buckets, bdd_clause_database, iLearntsPtr, iLearntsSize, this]() {
                 
@@ -1690,8 +3000,17 @@ lbool Solver::solve_(BddVarOrdering* bdd_var_ordering, bool do_simp, bool turn_o
         });
 
         // Wait for the Rust thread to finish
-        rust_thread.join();
+        {
+            PhaseScope wait(*this, phaseBddWait);
+            rust_thread.join();
         }
+        bddTime += realTime() - bddStart;
+        nbBddRuns++;
+        nbBddLitsSent += iLearntsSize;
+        }
+
+        if (bddStrengthen && bddAllowed && status == l_Undef && !strengthenLearntsWithBDD(rust_lib, bdd_var_ordering, bdd_buckets))
+            status = l_False;
     }
 
 
@@ -1715,6 +3034,7 @@ lbool Solver::solve_(BddVarOrdering* bdd_var_ordering, bool do_simp, bool turn_o
 
 
     cancelUntil(0);
+    updateMemoryAccount();
 
 
     double finalTime = cpuTime();
@@ -1727,9 +3047,7 @@ lbool Solver::solve_(BddVarOrdering* bdd_var_ordering, bool do_simp, bool turn_o
         totalTime4Unsat +=(finalTime-curTime);
     }
 
-    // Unload the Rust library
-    unloadRustLibrary(rust_lib);
-
+    // The BDD side stays loaded for the next call, see 'releaseBddState'
     return status;
 
 }
@@ -1850,6 +3168,26 @@ void Solver::relocAll(ClauseAllocator& to) {
     for (int i = 0; i < learnts.size(); i++)
         ca.reloc(learnts[i], to);
 
+    // Learnt clauses waiting for the BDD side (removed ones are dropped):
+    //
+    int i, j;
+    for (i = j = 0; i < bdd_strengthen_queue.size(); i++)
+        if (ca[bdd_strengthen_queue[i]].mark() != 1) {
+            ca.reloc(bdd_strengthen_queue[i], to);
+            bdd_strengthen_queue[j++] = bdd_strengthen_queue[i];
+        }
+    bdd_strengthen_queue.shrink(i - j);
+
+    // Clauses of the pseudo-Boolean constraints: the reasons were relocated with the trail, the
+    // others are dropped:
+    //
+    for (i = j = 0; i < pbReasons.size(); i++)
+        if (ca[pbReasons[i]].reloced()) {
+            ca.reloc(pbReasons[i], to);
+            pbReasons[j++] = pbReasons[i];
+        }
+    pbReasons.shrink(i - j);
+
     // All original:
     //
     for (int i = 0; i < clauses.size(); i++)
@@ -1862,11 +3200,13 @@ void Solver::relocAll(ClauseAllocator& to) {
 
 
 void Solver::garbageCollect() {
+    PhaseScope phase(*this, phaseGarbage);
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted());
 
     relocAll(to);
+    updateMemoryAccount(&to);
     if (verbosity >= 2)
         printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n",
             ca.size() * ClauseAllocator::Unit_Size, to.size() * ClauseAllocator::Unit_Size);
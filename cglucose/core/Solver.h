@@ -55,8 +55,14 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "utils/Options.h"
 #include "core/SolverTypes.h"
 #include "core/BoundedQueue.h"
+#include "core/LogHistogram.h"
+#include "core/Checkpoint.h"
 #include "core/Constants.h"
+#include "utils/PerfCounters.h"
+#include "utils/PhaseTimer.h"
+#include "utils/MemoryAccount.h"
 #include "mtl/Clone.h"
+#include <signal.h>
 #include <unordered_map>
 #include <iostream>
 #include <list>
@@ -69,12 +75,18 @@ typedef struct BddClauseDatabase BddClauseDatabase;
 
 namespace Glucose {
 
+class LearntLog;
+
 //=================================================================================================
 // Solver -- the main class:
 
 class Solver : public Clone {
 
     friend class SolverConfiguration;
+    friend class ModelCounter;
+    friend class Enumerator;
+    friend class Backbone;
+    friend class Bmc;
 
 public:
 
@@ -102,6 +114,10 @@ public:
     bool    addClause (Lit p, Lit q, Lit r);                    // Add a ternary clause to the solver. 
     virtual bool    addClause_(      vec<Lit>& ps);                     // Add a clause to the solver without making superflous internal copy. Will
                                                                 // change the passed vector 'ps'.
+    virtual void    beginBulkLoad(int nb_vars, uint64_t nb_clauses, uint64_t nb_lits); // Pre-size the structures for a problem of this size, which
+    virtual void    endBulkLoad  () {}                          // is then added with 'newVar' and 'addClause_' between these two calls.
+    virtual bool    addPb_    (vec<Lit>& lits, vec<int64_t>& weights, int64_t bound); // Add the pseudo-Boolean constraint 'sum weights[i] * lits[i] <= bound'
+                                                                // (positive weights, one term per variable), propagated natively. Changes the vectors.
     // Solving:
     //
     bool    simplify     ();                        // Removes already satisfied clauses.
@@ -111,6 +127,7 @@ public:
     bool    solve        (BddVarOrdering* bdd_var_ordering, Lit p);                   // Search for a model that respects a single assumption.
     bool    solve        (BddVarOrdering* bdd_var_ordering, Lit p, Lit q);            // Search for a model that respects two assumptions.
     bool    solve        (BddVarOrdering* bdd_var_ordering, Lit p, Lit q, Lit r);     // Search for a model that respects three assumptions.
+    static BddVarOrdering* initBddOrdering(const char* file);                          // Variable ordering of the BDD side for a plain DIMACS file (NULL otherwise, or if not available).
     bool    okay         () const;                  // FALSE means solver is in a conflicting state
 
        // Convenience versions of 'toDimacs()':
@@ -141,6 +158,7 @@ public:
     int     nAssigns   ()      const;       // The current number of assigned literals.
     int     nClauses   ()      const;       // The current number of original clauses.
     int     nLearnts   ()      const;       // The current number of learnt clauses.
+    int     nPbs       ()      const;       // The current number of native pseudo-Boolean constraints.
     int     nTmpSend   ()      const;       // The current number of literals in the clause to export.
     int     nVars      ()      const;       // The current number of variables.
     int     nFreeVars  ()      const;
@@ -151,6 +169,12 @@ public:
     void setIncrementalMode();
     void initNbInitialVars(int nb);
     void printIncrementalStats();
+    void writeStats(JsonWriter& json) const; // Write the statistics as fields of the current JSON object.
+
+    // Statistics snapshots of a running search (e.g. on SIGUSR1)
+    static void requestSnapshot();       // Async-signal-safe: every solver writes a snapshot at its next conflict.
+    static int  nbSnapshotRequests() { return snapshotRequests; }
+    virtual void writeSnapshot(JsonWriter& json); // Statistics, learnt tiers, memory and BDD queues of the search.
 
     bool isIncremental();
     // Resource contraints:
@@ -209,6 +233,76 @@ public:
     // Constant for Memory managment
     double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
 
+    // Constants for the BDD strengthening of learnt clauses
+    bool         bddStrengthen;          // Send long learnt clauses to the BDD side to get shorter implied sub-clauses.
+    int          bddStrengthenMinSize;   // Min size of a learnt clause to be strengthened.
+    unsigned int bddStrengthenMaxLBD;    // Max LBD of a learnt clause to be strengthened.
+    int          bddStrengthenMaxBuckets;// Max number of BDD buckets the variables of a clause may fall into.
+
+    // Memory budget, split between the clause arena and the BDD side (0 means no budget)
+    double       bddMemFrac;             // Fraction of the memory budget given to the BDD side.
+    int          bddNodeBytes;           // Estimated size of a BDD node, to turn bytes into nodes.
+    int          bddPauseRestarts;       // Restarts without BDD calls the first time the BDD side exceeds its budget (doubled each time).
+    uint64_t     arenaMemBudget;         // Max size of the clause arena in bytes before a clause database reduction is forced.
+    uint64_t     bddNodeBudget;          // Max number of BDD nodes.
+    void         setMemoryBudget(uint64_t bytes); // Split a memory budget between the clause arena and the BDD side.
+
+    // Time and hardware performance counters per phase (see PhaseTimer.h and PerfCounters.h)
+    bool          timePhases;            // Accumulate the time spent in each phase.
+    PhaseTimer    phaseTimer;
+    bool          perfCounters;          // Open the counters of the solving thread at the first call to solve or eliminate.
+    PerfCounters* perf;                  // NULL if disabled or refused by the kernel.
+
+    // Checkpoints of the search (see Checkpoint.h)
+    const char*  checkpointFile;         // Write checkpoints at restarts to this file (NULL means never).
+    int          checkpointEvery;        // Wall time in seconds between two checkpoints (0 means only on request).
+    const char*  checkpointName;         // Name of the instance, recorded in the checkpoint and checked when loading it.
+    uint64_t     nbCheckpoints;
+    static void  requestCheckpoint();    // Async-signal-safe: write a checkpoint at the next restart.
+    bool         writeCheckpoint(const char* file);       // Must be called at level 0. Returns false on an I/O error.
+    bool         loadCheckpoint (const char* file);       // Restore the state saved in 'file' into an empty solver. Returns false on error.
+
+    // Warm start from a previous run on a related instance (variables are named by their DIMACS index)
+    int          warmMaxSize;            // Max size of a learnt clause exported for a warm start.
+    unsigned int warmMaxLBD;             // Max LBD of a learnt clause exported for a warm start.
+    uint64_t     nbWarmClauses, nbWarmHints; // Imported clauses which are implied, and the others (only used as hints).
+    bool         writeWarmStart(const char* file); // Phases, activities and short learnt clauses. Must be called at level 0.
+    bool         loadWarmStart (const char* file); // Must be called at level 0, before solving. Returns false if the file could not be read.
+
+    // Logs of learnt clauses, to seed later runs on the same formula (see LearntLog.h)
+    unsigned int learntLogLBD;           // Learnt clauses of at most this LBD are logged (units and binaries always are).
+    uint64_t     nbSeededClauses;        // Clauses imported from a log.
+    uint64_t     problemHash() const;    // Identifies the formula: call it once loaded, before any simplification.
+    bool         openLearntLog (const char* file, uint64_t problem_hash); // Log the learnt clauses of the search to 'file'.
+    bool         closeLearntLog();       // Returns false if some clauses could not be written.
+    bool         loadLearntLog (const char* file, uint64_t problem_hash); // Must be called at level 0, before solving. Returns false if the log was not used.
+
+    // Distributions of the search (see LogHistogram.h)
+    struct SearchHistograms {
+        LogHistogram lbd, size, backjump, trail, bddLemma; // Learnt clauses, backjump distance and trail length at conflicts, clauses from the BDD side.
+        void clear() { lbd.clear(); size.clear(); backjump.clear(); trail.clear(); bddLemma.clear(); }
+        void print() const {
+            lbd.print("learnt lbd"); size.print("learnt size"); backjump.print("backjump");
+            trail.print("trail at conflict"); bddLemma.print("bdd lemma size"); }
+        void writeJson(JsonWriter& json, const char* key) const {
+            json.beginObject(key);
+            lbd.writeJson(json, "lbd"); size.writeJson(json, "size"); backjump.writeJson(json, "backjump");
+            trail.writeJson(json, "trail"); bddLemma.writeJson(json, "bdd_lemma");
+            json.endObject(); }
+    };
+    bool             histograms;         // Maintain the histograms of the run.
+    int              histWindow;         // Report the histograms of every window of this many restarts (0 means never).
+    const char*      histFile;           // Append the window reports to this file (JSON lines), else print them.
+    SearchHistograms hist, histWin;      // Whole run and current window.
+
+    // Memory per data structure (see MemoryAccount.h)
+    bool          accountMemory;         // Collect the memory of the structures at each reduceDB, garbage collection and solve.
+    MemoryAccount memAccount;
+
+    // Snapshots on request (see requestSnapshot)
+    bool          snapshotOnRequest;     // Answer the requests at the next conflict.
+    const char*   snapshotFile;          // Append the snapshots to this file (NULL means stderr).
+
     // Certified UNSAT ( Thanks to Marijn Heule)
     FILE*               certifiedOutput;
     bool                certifiedUNSAT;
@@ -242,6 +336,11 @@ public:
     //
     uint64_t nbRemovedClauses,nbRemovedUnaryWatchedClauses, nbReducedClauses,nbDL2,nbBin,nbUn,nbReduceDB,solves, starts, decisions, rnd_decisions, propagations, conflicts,conflictsRestarts,nbstopsrestarts,nbstopsrestartssame,lastblockatrestart;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t nbBddStrengthened, nbBddStrengthenedLits; // Learnt clauses shortened by the BDD side and literals removed from them
+    uint64_t nbBddShrinks, nbBddPauses, bddPeakNodes, nbArenaReductions; // Reactions to the memory budget
+    uint64_t nbBddRuns, nbBddLitsSent, nbBddClauses; // Calls to the BDD side, literals sent to it and clauses received from it
+    double   bddTime;                                // Wall time spent waiting for the BDD side
+    uint64_t nbPbPropagations, nbPbConflicts;        // Literals implied and conflicts found by the pseudo-Boolean constraints
 
 
 
@@ -294,6 +393,17 @@ protected:
     struct VarData { CRef reason; int level; };
     static inline VarData mkVarData(CRef cr, int l){ VarData d = {cr, l}; return d; }
 
+    // Attributes the enclosing scope to a phase of the search (see PhaseTimer.h and PerfCounters.h)
+    struct PhaseScope {
+        Solver& s;
+        PhaseScope(Solver& _s, int phase) : s(_s) {
+            if (s.timePhases) s.phaseTimer.enter(phase);
+            if (s.perf) s.perf->enter(phase); }
+        ~PhaseScope() {
+            if (s.perf) s.perf->leave();
+            if (s.timePhases) s.phaseTimer.leave(); }
+    };
+
     struct Watcher {
         CRef cref;
         Lit  blocker;
@@ -362,6 +472,21 @@ protected:
 
     ClauseAllocator     ca;
 
+    // Native pseudo-Boolean constraints 'sum w_i * l_i <= bound' (see addPb_), their terms in order of
+    // decreasing weight. 'sum' is the weight of the terms true among trail[0 .. pbHead-1]: the literals
+    // after 'pbHead' are not counted yet, and the ones undone by 'cancelUntil' are taken back.
+    struct PbConstraint { int first, size; int64_t bound, sum; };
+    struct PbOcc        { int pb; int64_t weight; };
+    vec<PbConstraint>   pbs;
+    vec<Lit>            pbLits;           // The terms of all the constraints, 'size' of them from 'first'.
+    vec<int64_t>        pbWeights;
+    vec<vec<PbOcc> >    pbOccs;           // 'pbOccs[toInt(l)]': the constraints whose sum grows when 'l' is true.
+    int                 pbHead;           // Head of the queue of the pseudo-Boolean propagation (index into the trail).
+    vec<CRef>           pbReasons;        // Clauses allocated as reasons and conflicts of the constraints, not attached.
+    int                 pbPurgeAt;        // Free the ones which are no longer reasons when there are this many.
+    vec<int>            pb_true;          // Temporaries of 'propagatePb' (indices of true terms).
+    vec<Lit>            pb_tmp;
+
     int nbclausesbeforereduce;            // To know when it is time to reduce clause database
     
     // Used for restart strategies
@@ -383,6 +508,14 @@ protected:
     std::vector<int>    tmp_learnts;
     std::vector<int>    internal_learnts;
     std::vector<CRef>   bdd_clauses;        // List of received learnt clauses.
+    vec<CRef>           bdd_strengthen_queue; // Learnt clauses waiting to be strengthened by the BDD side.
+    uint64_t            bddPausedUntil;     // No BDD call before this restart.
+    int                 bddPauseLength;     // Length of the next pause of the BDD side, in restarts.
+    uint64_t            lastArenaReduction; // Conflicts at the last clause database reduction forced by the arena budget.
+    void*               bddLib;             // State of the BDD side, kept across the calls to 'solve_'
+    BddVarOrdering*     bddStateOrdering;   // with the same ordering (see 'acquireBddState').
+    BddBuckets*         bddBuckets;
+    BddClauseDatabase*  bddClauseDb;
 
     //DR
     using BDDClauses = std::vector<vec<Lit>>;
@@ -403,6 +536,12 @@ protected:
     int64_t             conflict_budget;    // -1 means no budget.
     int64_t             propagation_budget; // -1 means no budget.
     bool                asynch_interrupt;
+    static volatile sig_atomic_t snapshotRequests; // Incremented by 'requestSnapshot'.
+    static volatile sig_atomic_t checkpointRequests; // Incremented by 'requestCheckpoint'.
+    int                 checkpointsSeen;    // Requests already answered by this solver.
+    double              lastCheckpoint;     // Wall time of the last checkpoint (or of the start of the search).
+    int                 snapshotsSeen;      // Requests already answered by this solver.
+    LearntLog*          learntLog;          // NULL unless the learnt clauses are logged.
 
     // Variables added for incremental mode
     int incremental; // Use incremental SAT Solver
@@ -420,6 +559,10 @@ protected:
     void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
+    CRef     propagateClauses ();                                                      // Unit propagation of the clauses only.
+    CRef     propagatePb      ();                                                      // Propagation of the pseudo-Boolean constraints (see 'pbHead').
+    CRef     explainPb        (int first, int64_t need, Lit implied);                  // Clause of 'implied' and of the negation of true terms weighing more than 'need'.
+    void     purgePbReasons   ();                                                      // Free the clauses of 'pbReasons' which are no longer reasons.
     CRef     propagateUnaryWatches(Lit p);                                                  // Perform propagation on unary watches of p, can find only conflicts
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
     void     analyze          (CRef confl, vec<Lit>& out_learnt, vec<Lit> & selectors, int& out_btlevel,unsigned int &nblevels,unsigned int &szWithoutSelectors);    // (bt = backtrack)
@@ -441,9 +584,26 @@ protected:
 
     // lk
     bool     addLearntClause(vec<Lit> &learnt_clause);
+    bool     addLearntClause(vec<Lit> &learnt_clause, CRef cr); // Replace the learnt clause 'cr' in place by an implied sub-clause.
+    bool     strengthenLearntsWithBDD(void* rust_lib, BddVarOrdering* bdd_var_ordering, BddBuckets* bdd_buckets);
+    bool     bddWithinBudget  (void* rust_lib, BddBuckets* bdd_buckets); // True if the BDD side may be called at this restart.
+    bool     acquireBddState  (BddVarOrdering* bdd_var_ordering); // Load the BDD side for an ordering, or keep the loaded one.
+    void     releaseBddState  ();                      // Free the state of the BDD side and unload its library.
+    bool     arenaOverBudget  () const;
+    void     openPerfCounters ();                      // Open the counters of the calling thread if 'perfCounters' is set.
+    void     answerSnapshot   ();                      // Append a snapshot to 'snapshotFile' (or stderr).
+    void     reportHistogramWindow();                  // Report and clear the histograms of the current window.
+    void     checkpointIfDue  ();                      // Write a checkpoint if one was requested or the period elapsed.
+    virtual void writeCheckpointExtra(CheckpointWriter& out) const; // State of the subclasses, after the one of the solver.
+    virtual bool readCheckpointExtra (CheckpointReader& in);
+    bool     readCheckpointClause(CheckpointReader& in, int size, vec<Lit>& lits);
+    bool     restoreLearnt    (vec<Lit>& lits, unsigned int lbd, float act, bool canBeDel); // Add a learnt clause read from a checkpoint (at level 0).
+    virtual bool canImport    (Var v) const { return true; } // False for the variables an imported clause must not mention.
+    virtual void collectMemory(MemoryAccount& acc) const; // Record the memory held by each structure.
+    void     updateMemoryAccount(const ClauseAllocator* gcCopy = NULL); // 'gcCopy' is the new arena during a garbage collection.
     void     translateLearntClauses(std::vector<int> learnt_clauses);
-    void*    loadRustLibrary();
-    void     unloadRustLibrary(void* rust_lib);
+    static void* loadRustLibrary();
+    static void  unloadRustLibrary(void* rust_lib);
 
     // D
     void writeLearntClause(CRef);
@@ -461,6 +621,7 @@ protected:
     void     removeClause     (CRef cr, bool inPurgatory = false);               // Detach and free a clause.
     bool     locked           (const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
+    bool     implied          (const vec<Lit>& c);     // Returns TRUE if the clause is implied by unit propagation (RUP) at level 0.
 
     unsigned int computeLBD(const vec<Lit> & lits,int end=-1);
     unsigned int computeLBD(const Clause &c);
@@ -554,6 +715,7 @@ inline lbool    Solver::modelValue    (Lit p) const   { return model[var(p)] ^ s
 inline int      Solver::nAssigns      ()      const   { return trail.size(); }
 inline int      Solver::nClauses      ()      const   { return clauses.size(); }
 inline int      Solver::nLearnts      ()      const   { return learnts.size(); }
+inline int      Solver::nPbs          ()      const   { return pbs.size(); }
 inline int      Solver::nVars         ()      const   { return vardata.size(); }
 inline int      Solver::nFreeVars     ()      const   { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
 inline void     Solver::setPolarity   (Var v, bool b) { polarity[v] = b; }
@@ -569,6 +731,8 @@ inline void     Solver::setConfBudget(int64_t x){ conflict_budget    = conflicts
 inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagations + x; }
 inline void     Solver::interrupt(){ asynch_interrupt = true; }
 inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
+inline void     Solver::requestSnapshot(){ snapshotRequests = snapshotRequests + 1; }
+inline void     Solver::requestCheckpoint(){ checkpointRequests = checkpointRequests + 1; }
 inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
 inline bool     Solver::withinBudget() const {
     return !asynch_interrupt &&
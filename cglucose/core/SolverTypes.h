@@ -278,6 +278,12 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
     ClauseAllocator(uint32_t start_cap) : RegionAllocator<uint32_t>(start_cap), extra_clause_field(false){}
     ClauseAllocator() : extra_clause_field(false){}
 
+    // Room for 'nb_clauses' more problem clauses with 'nb_lits' literals in total.
+    void reserveClauses(uint64_t nb_clauses, uint64_t nb_lits){
+        if (nb_clauses >= UINT32_MAX || nb_lits >= UINT32_MAX) return;   // Would not fit anyway (and the product could overflow)
+        uint64_t words = nb_clauses * clauseWord32Size(0, extra_clause_field ? 1 : 0) + nb_lits;
+        if (words + size() < UINT32_MAX) reserve((uint32_t)words); }
+
     void moveTo(ClauseAllocator& to){
         to.extra_clause_field = extra_clause_field;
         RegionAllocator<uint32_t>::moveTo(to); }
@@ -358,6 +364,10 @@ class OccLists
     Vec&  lookup    (const Idx& idx){ if (dirty[toInt(idx)]) clean(idx); return occs[toInt(idx)]; }
 
     void  cleanAll  ();
+    uint64_t bytes  () const {  // Heap memory held by the lists.
+        uint64_t b = occs.bytes() + dirty.bytes() + dirties.bytes();
+        for (int i = 0; i < occs.size(); i++) b += occs[i].bytes();
+        return b; }
     void copyTo(OccLists &copy) const {
 	
 	copy.occs.growTo(occs.size());
@@ -0,0 +1,188 @@
+/*
+    Synthetic instance generators.
+    See Generators.h
+*/
+
+#include <set>
+
+#include "gen/Generators.h"
+
+using namespace Glucose;
+
+
+void Cnf::addXor(int c, int a, int b)
+{
+    add(-a, -b, -c);
+    add( a,  b, -c);
+    add( a, -b,  c);
+    add(-a,  b,  c);
+}
+
+
+void Cnf::write(FILE* out) const
+{
+    for (size_t i = 0, j; i < comment.size(); i = j + 1) {
+        j = comment.find('\n', i);
+        if (j == std::string::npos) j = comment.size();
+        fprintf(out, "c %s\n", comment.substr(i, j - i).c_str());
+    }
+    fprintf(out, "p cnf %d %d\n", nVars, (int)clauses.size());
+    for (size_t i = 0; i < clauses.size(); i++) {
+        for (size_t j = 0; j < clauses[i].size(); j++)
+            fprintf(out, "%d ", clauses[i][j]);
+        fprintf(out, "0\n");
+    }
+}
+
+
+//=================================================================================================
+// Families:
+
+
+// 'ratio * vars' clauses of 'k' distinct variables with random signs.
+void Glucose::genRandomKSat(Cnf& f, int vars, int k, double ratio, uint64_t seed)
+{
+    GenRandom rnd(seed);
+    if (k > vars) k = vars;
+    f.nVars = vars;
+    int m = (int)(ratio * vars + 0.5);
+    std::vector<int> c;
+    for (int i = 0; i < m; i++) {
+        c.clear();
+        while ((int)c.size() < k) {
+            int v = rnd.below(vars) + 1;
+            bool dup = false;
+            for (size_t j = 0; j < c.size(); j++) dup |= abs(c[j]) == v;
+            if (!dup) c.push_back(rnd.coin() ? v : -v);
+        }
+        f.add(c);
+    }
+}
+
+
+// 'holes + 1' pigeons in 'holes' holes: every pigeon in a hole, no two pigeons in the same hole.
+void Glucose::genPigeonhole(Cnf& f, int holes)
+{
+    int pigeons = holes + 1;
+    f.nVars = pigeons * holes;
+    std::vector<int> c;
+    for (int p = 0; p < pigeons; p++) {
+        c.clear();
+        for (int h = 0; h < holes; h++) c.push_back(p * holes + h + 1);
+        f.add(c);
+    }
+    for (int h = 0; h < holes; h++)
+        for (int p = 0; p < pigeons; p++)
+            for (int q = p + 1; q < pigeons; q++)
+                f.add(-(p * holes + h + 1), -(q * holes + h + 1));
+}
+
+
+// x1 ^ ... ^ xn = 1 along the natural order and = 0 along a random order, each chain with its
+// own Tseitin variables.
+void Glucose::genParity(Cnf& f, int vars, uint64_t seed)
+{
+    GenRandom rnd(seed);
+    f.nVars = vars;
+    std::vector<int> order(vars);
+    for (int i = 0; i < vars; i++) order[i] = i + 1;
+
+    for (int chain = 0; chain < 2; chain++) {
+        if (chain == 1) rnd.shuffle(order);
+        int acc = order[0];
+        for (int i = 1; i < vars; i++) {
+            int next = f.newVar();
+            f.addXor(next, acc, order[i]);
+            acc = next;
+        }
+        f.add(chain == 0 ? acc : -acc);
+    }
+}
+
+
+// 'groups * 4' variables. A first random partition in groups of 4 allows at most one true
+// variable per group (at most 'groups' true variables), a second one in groups of 3 (the last
+// variables are left out) requires at least one (at least 'groups * 4 / 3' true variables).
+// This is a contradiction from 3 groups on: with 1 or 2 groups the formula is satisfiable.
+void Glucose::genSgen(Cnf& f, int groups, uint64_t seed)
+{
+    GenRandom rnd(seed);
+    int vars = groups * 4;
+    f.nVars = vars;
+    std::vector<int> perm(vars), c;
+    for (int i = 0; i < vars; i++) perm[i] = i + 1;
+
+    rnd.shuffle(perm);
+    for (int g = 0; g < groups; g++)
+        for (int i = 0; i < 4; i++)
+            for (int j = i + 1; j < 4; j++)
+                f.add(-perm[4 * g + i], -perm[4 * g + j]);
+
+    rnd.shuffle(perm);
+    for (int g = 0; 3 * g + 3 <= vars; g++) {
+        c.assign(perm.begin() + 3 * g, perm.begin() + 3 * g + 3);
+        f.add(c);
+    }
+}
+
+
+// A random graph with 'edgeRatio * vertices' distinct edges. Variable (v, c) means that vertex
+// 'v' has color 'c': every vertex has exactly one color, adjacent vertices different ones.
+void Glucose::genColoring(Cnf& f, int vertices, double edgeRatio, int colors, uint64_t seed)
+{
+    GenRandom rnd(seed);
+    f.nVars = vertices * colors;
+    std::vector<int> c;
+    for (int v = 0; v < vertices; v++) {
+        c.clear();
+        for (int k = 0; k < colors; k++) c.push_back(v * colors + k + 1);
+        f.add(c);
+        for (int k = 0; k < colors; k++)
+            for (int l = k + 1; l < colors; l++)
+                f.add(-(v * colors + k + 1), -(v * colors + l + 1));
+    }
+
+    long long maxEdges = (long long)vertices * (vertices - 1) / 2;
+    long long m = (long long)(edgeRatio * vertices + 0.5);
+    if (m > maxEdges) m = maxEdges;
+    std::set<std::pair<int, int> > edges;
+    while ((long long)edges.size() < m) {
+        int a = rnd.below(vertices), b = rnd.below(vertices);
+        if (a == b) continue;
+        if (a > b) std::swap(a, b);
+        if (!edges.insert(std::make_pair(a, b)).second) continue;
+        for (int k = 0; k < colors; k++)
+            f.add(-(a * colors + k + 1), -(b * colors + k + 1));
+    }
+}
+
+
+// A 'bits' wide counter starting at 0, incremented at each step when the input of the step is
+// set, unrolled over 'steps' steps. The last state must be 'target': satisfiable if and only if
+// target < 2^bits and target <= steps.
+void Glucose::genCounterBmc(Cnf& f, int bits, int steps, uint64_t target)
+{
+    std::vector<int> state(bits), next(bits);
+    for (int i = 0; i < bits; i++) {
+        state[i] = f.newVar();
+        f.add(-state[i]);
+    }
+    for (int t = 0; t < steps; t++) {
+        int carry = f.newVar();   // The input of the step is the carry into bit 0
+        for (int i = 0; i < bits; i++) {
+            next[i] = f.newVar();
+            f.addXor(next[i], state[i], carry);
+            if (i + 1 < bits) {
+                int out = f.newVar(); // out <-> state[i] & carry
+                f.add(-out, state[i]);
+                f.add(-out, carry);
+                f.add(out, -state[i], -carry);
+                carry = out;
+            }
+        }
+        state.swap(next);
+    }
+    for (int i = 0; i < bits; i++)
+        f.add(i < 64 && (target >> i) & 1 ? state[i] : -state[i]);
+    if (bits < 64 && (target >> bits) != 0) f.add(std::vector<int>());   // Unreachable target
+}
@@ -0,0 +1,97 @@
+/*
+    Synthetic instance generators for scaling studies.
+
+    Every family is parameterized by its size and, when it is random, by a seed: the same
+    parameters always give the same formula (the generator does not depend on the standard
+    library random engines). The families cover both kinds of structure for the BDD side:
+      - random k-SAT           : no structure, hostile to BDDs (and to CDCL above the threshold);
+      - pigeonhole             : unsatisfiable, exponential for resolution and hostile to BDDs;
+      - parity                 : two XOR chains over the same variables with different orders and
+                                 opposite parities; unsatisfiable, hard for CDCL, small BDDs;
+      - sgen                   : cardinality contradiction over two random partitions (in the
+                                 spirit of sgen1), small and hard; at least 3 groups;
+      - graph coloring         : random graph with a given edge ratio and number of colors;
+      - counter BMC            : a counter with an enable input per step, unrolled over a number
+                                 of steps, reaching a target value. Narrow chains, BDD friendly.
+*/
+
+#ifndef Glucose_Generators_h
+#define Glucose_Generators_h
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "mtl/IntTypes.h"
+#include "mtl/Vec.h"
+#include "core/SolverTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// Cnf -- a formula in DIMACS numbering:
+
+class Cnf {
+public:
+    int                            nVars;
+    std::vector<std::vector<int> > clauses;
+    std::string                    comment;   // Written as 'c' lines before the header.
+
+    Cnf() : nVars(0) {}
+
+    int  newVar() { return ++nVars; }
+    void add(const std::vector<int>& c) { clauses.push_back(c); }
+    void add(int a)                     { add(std::vector<int>(1, a)); }
+    void add(int a, int b)              { int c[] = { a, b };    add(std::vector<int>(c, c + 2)); }
+    void add(int a, int b, int c)       { int d[] = { a, b, c }; add(std::vector<int>(d, d + 3)); }
+    void addXor(int c, int a, int b);   // c <-> a xor b
+
+    void write(FILE* out) const;
+
+    // Add the formula to a solver.
+    template<class Solver>
+    bool load(Solver& S) const {
+        vec<Lit> lits;
+        while (S.nVars() < nVars) S.newVar();
+        for (size_t i = 0; i < clauses.size(); i++) {
+            lits.clear();
+            for (size_t j = 0; j < clauses[i].size(); j++)
+                lits.push(clauses[i][j] > 0 ? mkLit(clauses[i][j] - 1) : ~mkLit(-clauses[i][j] - 1));
+            if (!S.addClause_(lits)) return false;
+        }
+        return true;
+    }
+};
+
+//=================================================================================================
+// GenRandom -- a small deterministic random generator (splitmix64):
+
+class GenRandom {
+    uint64_t state;
+public:
+    GenRandom(uint64_t seed) : state(seed) {}
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31); }
+    int  below(int n) { return (int)(next() % (uint64_t)n); }   // Uniform in [0, n).
+    bool coin()       { return next() >> 63; }
+    void shuffle(std::vector<int>& v) {
+        for (int i = (int)v.size() - 1; i > 0; i--) std::swap(v[i], v[below(i + 1)]); }
+};
+
+//=================================================================================================
+// Families:
+
+void genRandomKSat (Cnf& f, int vars, int k, double ratio, uint64_t seed);
+void genPigeonhole (Cnf& f, int holes);
+void genParity     (Cnf& f, int vars, uint64_t seed);
+void genSgen       (Cnf& f, int groups, uint64_t seed);
+void genColoring   (Cnf& f, int vertices, double edgeRatio, int colors, uint64_t seed);
+void genCounterBmc (Cnf& f, int bits, int steps, uint64_t target);
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+    glucose-gen: deterministic synthetic instances for benchmarks and scaling studies.
+
+    Usage: glucose-gen -family=<name> [options] [output-file]
+    The formula is written in DIMACS on the output file (standard output by default). The same
+    options always give the same formula, see gen/Generators.h for the families.
+*/
+
+#include <errno.h>
+#include <string.h>
+
+#include "utils/System.h"
+#include "utils/Options.h"
+#include "gen/Generators.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Options:
+
+
+static const char* _cat = "GEN";
+
+static StringOption opt_family (_cat, "family", "Family of the instance (ksat, php, parity, sgen, color, bmc)", "ksat");
+static IntOption    opt_n      (_cat, "n",      "Size: variables (ksat, parity), holes (php), groups (sgen, at least 3), vertices (color), bits (bmc)", 100, IntRange(1, INT32_MAX));
+static IntOption    opt_k      (_cat, "k",      "Clause length (ksat) or number of colors (color)", 3, IntRange(1, INT32_MAX));
+static DoubleOption opt_ratio  (_cat, "ratio",  "Clauses per variable (ksat) or edges per vertex (color)", 4.26, DoubleRange(0, true, HUGE_VAL, false));
+static IntOption    opt_steps  (_cat, "steps",  "Number of unrolled steps (bmc)", 16, IntRange(0, INT32_MAX));
+static Int64Option  opt_target (_cat, "target", "Value the counter must reach (bmc, -1 means the number of steps)", -1, Int64Range(-1, INT64_MAX));
+static Int64Option  opt_seed   (_cat, "seed",   "Seed of the random families", 1, Int64Range(0, INT64_MAX));
+
+
+//=================================================================================================
+// Main:
+
+
+int main(int argc, char** argv)
+{
+    setUsageHelp("USAGE: %s -family=<name> [options] [output-file]\n\n  where the formula is written in DIMACS (standard output by default).\n");
+    parseOptions(argc, argv, true);
+    if (argc > 2) {
+        fprintf(stderr, "ERROR! Too many arguments\n");
+        exit(1);
+    }
+
+    const char* family = opt_family;
+    uint64_t    seed   = (uint64_t)(int64_t)opt_seed;
+    Cnf         f;
+    char        buf[256];
+
+    if (strcmp(family, "ksat") == 0) {
+        genRandomKSat(f, opt_n, opt_k, opt_ratio, seed);
+        sprintf(buf, "random %d-SAT, %d variables, ratio %g, seed %" PRIu64, (int)opt_k, (int)opt_n, (double)opt_ratio, seed);
+    } else if (strcmp(family, "php") == 0) {
+        genPigeonhole(f, opt_n);
+        sprintf(buf, "pigeonhole, %d holes", (int)opt_n);
+    } else if (strcmp(family, "parity") == 0) {
+        genParity(f, opt_n, seed);
+        sprintf(buf, "parity chains, %d variables, seed %" PRIu64, (int)opt_n, seed);
+    } else if (strcmp(family, "sgen") == 0) {
+        if (opt_n < 3) {
+            fprintf(stderr, "ERROR! sgen needs at least 3 groups (with fewer the formula is satisfiable)\n");
+            exit(1);
+        }
+        genSgen(f, opt_n, seed);
+        sprintf(buf, "sgen, %d groups, seed %" PRIu64, (int)opt_n, seed);
+    } else if (strcmp(family, "color") == 0) {
+        genColoring(f, opt_n, opt_ratio, opt_k, seed);
+        sprintf(buf, "graph coloring, %d vertices, edge ratio %g, %d colors, seed %" PRIu64, (int)opt_n, (double)opt_ratio, (int)opt_k, seed);
+    } else if (strcmp(family, "bmc") == 0) {
+        uint64_t target = opt_target < 0 ? (uint64_t)(int)opt_steps : (uint64_t)(int64_t)opt_target;
+        genCounterBmc(f, opt_n, opt_steps, target);
+        sprintf(buf, "counter BMC, %d bits, %d steps, target %" PRIu64, (int)opt_n, (int)opt_steps, target);
+    } else {
+        fprintf(stderr, "ERROR! Unknown family '%s'\n", family);
+        exit(1);
+    }
+    f.comment = buf;
+
+    FILE* out = argc == 2 ? fopen(argv[1], "wb") : stdout;
+    if (out == NULL) {
+        fprintf(stderr, "ERROR! Could not open file: %s (%s)\n", argv[1], strerror(errno));
+        exit(1);
+    }
+    f.write(out);
+    if (out != stdout) fclose(out);
+    return 0;
+}
@@ -0,0 +1,298 @@
+/*
+    glucose-harness: end-to-end performance regression harness.
+
+    Usage: glucose-harness [options] -manifest=<file>
+    The manifest lists one instance per line, optionally followed by a seed ('#' starts a comment).
+    Every instance is solved '-runs' times, each run in a forked process with its own CPU and
+    memory limits. The measurements are written as JSON lines to '-out'; such a file can be given
+    as '-baseline' to a later run, which compares the wall and CPU times of every instance with
+    Welch's t-test. A significant slowdown larger than '-threshold', or a change of status, is a
+    regression and makes the harness exit with status 1.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <new>
+#include <zlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/System.h"
+#include "utils/Options.h"
+#include "utils/Statistics.h"
+#include "utils/JsonWriter.h"
+#include "core/Dimacs.h"
+#include "core/BinaryCnf.h"
+#include "simp/SimpSolver.h"
+#include "harness/RunRecord.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Options:
+
+
+static const char* _cat = "HARNESS";
+
+static StringOption opt_manifest (_cat, "manifest",  "File listing the instances (one per line, optionally followed by a seed)");
+static StringOption opt_out      (_cat, "out",       "File receiving the measurements (JSON lines)", "harness.json");
+static StringOption opt_baseline (_cat, "baseline",  "Measurements of a previous run to compare with");
+static IntOption    opt_runs     (_cat, "runs",      "Number of runs per instance", 3, IntRange(1, INT32_MAX));
+static Int64Option  opt_seed     (_cat, "seed",      "Random seed of the instances without their own seed", 91648253, Int64Range(1, INT64_MAX));
+static IntOption    opt_cpu_lim  (_cat, "cpu-lim",   "Limit on CPU time of a run in seconds (0 means no limit)", 0, IntRange(0, INT32_MAX));
+static IntOption    opt_mem_lim  (_cat, "mem-lim",   "Limit on memory of a run in megabytes (0 means no limit)", 0, IntRange(0, INT32_MAX));
+static DoubleOption opt_threshold(_cat, "threshold", "Relative change of the mean time below which a significant difference is ignored", 0.05, DoubleRange(0, true, HUGE_VAL, false));
+
+
+//=================================================================================================
+// Runs:
+
+
+// Exit status of a child which ran out of memory. The parsers exit with 3 on a malformed input,
+// which is recorded as an error.
+static const int memOutExit = 4;
+
+
+// Body of the child process: solve the instance and write the counters of the solver as a JSON
+// object to 'fd'. The output of the solver (and of the BDD side) is discarded.
+static void child(const char* file, uint64_t seed, int fd)
+{
+    int devnull = open("/dev/null", O_WRONLY);
+    if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+
+    rlimit rl;
+    if (opt_cpu_lim > 0) {
+        rl.rlim_cur = opt_cpu_lim; rl.rlim_max = opt_cpu_lim + 1;
+        setrlimit(RLIMIT_CPU, &rl); }
+    if (opt_mem_lim > 0) {
+        rl.rlim_cur = rl.rlim_max = (rlim_t)opt_mem_lim * 1024 * 1024;
+        setrlimit(RLIMIT_AS, &rl); }
+
+    SimpSolver S;
+    S.verbosity = 0;
+    S.random_seed = (double)seed;
+    S.timePhases = true;           // The records break the time down per phase.
+    lbool ret;
+    try {
+        if (isBinaryCnf(file)) {
+            if (load_BinaryCnf(file, S) < 0) _exit(2);
+        } else {
+            InputStream* in = InputStream::open(file);
+            if (in == NULL) _exit(2);
+            parse_DIMACS(*in, S);
+            delete in; }
+
+        // The BDD side reads the input itself, as DIMACS text: binary and compressed inputs run
+        // without it.
+        vec<Lit> dummy;
+        ret = S.solveLimited(Solver::initBddOrdering(file), dummy);
+    } catch (OutOfMemoryException&) {
+        _exit(memOutExit);
+    } catch (std::bad_alloc&) {
+        _exit(memOutExit);
+    }
+
+    RunRecord rec;
+    rec.status = ret == l_True ? "SATISFIABLE" : ret == l_False ? "UNSATISFIABLE" : "INDETERMINATE";
+    rec.conflicts = S.conflicts;
+    rec.propagations = S.propagations;
+    rec.decisions = S.decisions;
+    rec.bddRuns = S.nbBddRuns;
+    rec.bddLitsSent = S.nbBddLitsSent;
+    rec.bddClauses = S.nbBddClauses;
+    rec.bddTime = S.bddTime;
+    for (int p = 0; p < nbSolverPhases; p++) rec.phaseTimes[p] = S.phaseTimer.seconds(p);
+    FILE* out = fdopen(fd, "w");
+    JsonWriter json(out);
+    rec.write(json);
+    fclose(out);
+    _exit(0);
+}
+
+
+static RunRecord runOnce(const char* file, uint64_t seed, int run)
+{
+    RunRecord rec;
+    rec.instance = file;
+    rec.run = run;
+    rec.seed = seed;
+
+    int fds[2];
+    if (pipe(fds) == -1) { rec.status = "CRASH"; return rec; }
+    fflush(stdout);
+    double start = realTime();
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        child(file, seed, fds[1]);
+    }
+    close(fds[1]);
+    if (pid < 0) { close(fds[0]); rec.status = "CRASH"; return rec; }
+
+    std::string line;
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0 || (n < 0 && errno == EINTR))
+        if (n > 0) line.append(buf, n);
+    close(fds[0]);
+
+    int status;
+    rusage ru;
+    while (wait4(pid, &status, 0, &ru) < 0 && errno == EINTR)
+        ;
+    rec.wall = realTime() - start;
+
+    RunRecord counters;
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && counters.parse(line.c_str())) {
+        counters.instance = rec.instance;
+        counters.run = rec.run;
+        counters.seed = rec.seed;
+        counters.wall = rec.wall;
+        rec = counters;
+    } else if (WIFSIGNALED(status) && (WTERMSIG(status) == SIGXCPU || WTERMSIG(status) == SIGKILL))
+        rec.status = "TIMEOUT";
+    else if (WIFEXITED(status) && WEXITSTATUS(status) == memOutExit)
+        rec.status = "MEMOUT";
+    else if (opt_mem_lim > 0 && WIFSIGNALED(status) && (WTERMSIG(status) == SIGABRT || WTERMSIG(status) == SIGSEGV))
+        rec.status = "MEMOUT";   // Allocation failures outside of the solver end with an abort or a segfault
+    else if (WIFEXITED(status))
+        rec.status = "ERROR";    // Unreadable or malformed input, or an error of the solver
+    else
+        rec.status = "CRASH";
+
+    rec.cpu = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 + ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+    rec.peakMem = ru.ru_maxrss / 1024.0;
+    return rec;
+}
+
+
+//=================================================================================================
+// Comparison:
+
+
+typedef std::map<std::string, std::vector<RunRecord> > Results;
+
+static bool loadResults(const char* file, Results& results)
+{
+    FILE* in = fopen(file, "rb");
+    if (in == NULL) return false;
+    char* line = NULL;
+    size_t cap = 0;
+    RunRecord rec;
+    while (getline(&line, &cap, in) != -1) {
+        rec = RunRecord();
+        if (rec.parse(line)) results[rec.instance].push_back(rec);
+    }
+    free(line);
+    fclose(in);
+    return true;
+}
+
+
+static void times(const std::vector<RunRecord>& runs, Sample& wall, Sample& cpu)
+{
+    wall.clear(); cpu.clear();
+    for (size_t i = 0; i < runs.size(); i++) { wall.push(runs[i].wall); cpu.push(runs[i].cpu); }
+}
+
+
+// Compare one measure of an instance. Returns true on a regression.
+static bool compare(const char* instance, const char* measure, const Sample& cur, const Sample& base)
+{
+    double t, df;
+    bool significant = Sample::welch(cur, base, t, df);
+    double change = base.mean() > 0 ? (cur.mean() - base.mean()) / base.mean() : 0;
+    const char* verdict = !significant || fabs(change) <= opt_threshold ? "same" : change > 0 ? "REGRESSION" : "improvement";
+    printf("c %-30s %-5s %10.3f %10.3f %+8.1f%% %8.2f   %s\n", instance, measure, base.mean(), cur.mean(), change * 100, t, verdict);
+    return strcmp(verdict, "REGRESSION") == 0;
+}
+
+
+//=================================================================================================
+// Main:
+
+
+int main(int argc, char** argv)
+{
+    setUsageHelp("USAGE: %s [options] -manifest=<file>\n");
+    parseOptions(argc, argv, true);
+    if (!opt_manifest) {
+        fprintf(stderr, "ERROR! No manifest given (use -manifest=<file>)\n");
+        exit(1);
+    }
+
+    FILE* manifest = fopen(opt_manifest, "rb");
+    if (manifest == NULL) {
+        fprintf(stderr, "ERROR! Could not open file: %s\n", (const char*)opt_manifest);
+        exit(1);
+    }
+    std::vector<std::pair<std::string, uint64_t> > instances;
+    char* line = NULL;
+    size_t cap = 0;
+    while (getline(&line, &cap, manifest) != -1) {
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char path[4096];
+        unsigned long long seed = opt_seed;
+        if (sscanf(line, "%4095s %llu", path, &seed) >= 1)
+            instances.push_back(std::make_pair(std::string(path), (uint64_t)seed));
+    }
+    free(line);
+    fclose(manifest);
+
+    FILE* out = fopen(opt_out, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "ERROR! Could not open file: %s\n", (const char*)opt_out);
+        exit(1);
+    }
+    JsonWriter json(out);
+
+    printf("c %-30s %-14s %10s %10s %12s %12s %10s %8s\n", "instance", "status", "wall (s)", "cpu (s)", "confl/s", "props/s", "mem (MB)", "BDD (s)");
+    Results results;
+    for (size_t i = 0; i < instances.size(); i++) {
+        for (int r = 0; r < opt_runs; r++) {
+            RunRecord rec = runOnce(instances[i].first.c_str(), instances[i].second, r);
+            rec.write(json);
+            json.flush();
+            results[rec.instance].push_back(rec);
+            printf("c %-30s %-14s %10.3f %10.3f %12.0f %12.0f %10.1f %8.2f\n", rec.instance.c_str(), rec.status.c_str(),
+                   rec.wall, rec.cpu, rec.conflictsPerSec(), rec.propagationsPerSec(), rec.peakMem, rec.bddTime);
+        }
+    }
+    fclose(out);
+
+    if (!opt_baseline) return 0;
+    Results baseline;
+    if (!loadResults(opt_baseline, baseline)) {
+        fprintf(stderr, "ERROR! Could not open file: %s\n", (const char*)opt_baseline);
+        exit(1);
+    }
+
+    printf("c\nc %-30s %-5s %10s %10s %9s %8s\n", "instance", "", "baseline", "current", "change", "t");
+    int regressions = 0;
+    Sample curWall, curCpu, baseWall, baseCpu;
+    for (Results::const_iterator it = results.begin(); it != results.end(); ++it) {
+        Results::const_iterator b = baseline.find(it->first);
+        if (b == baseline.end()) {
+            printf("c %-30s not in the baseline\n", it->first.c_str());
+            continue;
+        }
+        if (it->second[0].status != b->second[0].status) {
+            printf("c %-30s status changed: %s -> %s   REGRESSION\n", it->first.c_str(), b->second[0].status.c_str(), it->second[0].status.c_str());
+            regressions++;
+            continue;
+        }
+        times(it->second, curWall, curCpu);
+        times(b->second, baseWall, baseCpu);
+        regressions += compare(it->first.c_str(), "wall", curWall, baseWall);
+        regressions += compare(it->first.c_str(), "cpu", curCpu, baseCpu);
+    }
+    printf("c %d regression(s)\n", regressions);
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/*
+    Measurements of a run of the harness.
+    See RunRecord.h
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "harness/RunRecord.h"
+
+using namespace Glucose;
+
+
+void RunRecord::write(JsonWriter& json) const
+{
+    json.beginObject();
+    json.value("instance", instance.c_str());
+    json.value("run", run);
+    json.value("seed", seed);
+    json.value("status", status.c_str());
+    json.value("wall", wall);
+    json.value("cpu", cpu);
+    json.value("peak_mem_mb", peakMem);
+    json.value("conflicts", conflicts);
+    json.value("propagations", propagations);
+    json.value("decisions", decisions);
+    json.value("conflicts_per_sec", conflictsPerSec());
+    json.value("propagations_per_sec", propagationsPerSec());
+    json.value("bdd_runs", bddRuns);
+    json.value("bdd_lits_sent", bddLitsSent);
+    json.value("bdd_clauses", bddClauses);
+    json.value("bdd_time", bddTime);
+    for (int p = 0; p < nbSolverPhases; p++) {
+        std::string key = std::string("time_") + phaseName(p);
+        json.value(key.c_str(), phaseTimes[p]);
+    }
+    json.endObject();
+}
+
+
+static bool parseString(const char*& p, std::string& out)
+{
+    if (*p != '"') return false;
+    out.clear();
+    for (p++; *p && *p != '"'; p++) {
+        if (*p == '\\' && p[1]) {
+            p++;
+            out.push_back(*p == 'n' ? '\n' : *p == 't' ? '\t' : *p);
+        } else
+            out.push_back(*p);
+    }
+    if (*p != '"') return false;
+    p++;
+    return true;
+}
+
+
+bool RunRecord::parse(const char* line)
+{
+    const char* p = line;
+    while (*p == ' ') p++;
+    if (*p++ != '{') return false;
+
+    std::string key, str;
+    for (;;) {
+        while (*p == ' ' || *p == ',') p++;
+        if (*p == '}') return true;
+        if (!parseString(p, key) || *p++ != ':') return false;
+
+        if (*p == '"') {
+            if (!parseString(p, str)) return false;
+            if      (key == "instance") instance = str;
+            else if (key == "status")   status = str;
+        } else {
+            char* end;
+            double v = strtod(p, &end);
+            if (end == p) {
+                if (strncmp(p, "null", 4) != 0 && strncmp(p, "true", 4) != 0) {
+                    if (strncmp(p, "false", 5) != 0) return false;
+                    end = (char*)p + 5;
+                } else
+                    end = (char*)p + 4;
+                v = 0;
+            }
+            p = end;
+            if      (key == "run")          run = (int)v;
+            else if (key == "seed")         seed = (uint64_t)v;
+            else if (key == "wall")         wall = v;
+            else if (key == "cpu")          cpu = v;
+            else if (key == "peak_mem_mb")  peakMem = v;
+            else if (key == "conflicts")    conflicts = (uint64_t)v;
+            else if (key == "propagations") propagations = (uint64_t)v;
+            else if (key == "decisions")    decisions = (uint64_t)v;
+            else if (key == "bdd_runs")     bddRuns = (uint64_t)v;
+            else if (key == "bdd_lits_sent")bddLitsSent = (uint64_t)v;
+            else if (key == "bdd_clauses")  bddClauses = (uint64_t)v;
+            else if (key == "bdd_time")     bddTime = v;
+            else if (key.compare(0, 5, "time_") == 0)
+                for (int ph = 0; ph < nbSolverPhases; ph++)
+                    if (key.compare(5, std::string::npos, phaseName(ph)) == 0) phaseTimes[ph] = v;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+/*
+    The measurements of one run of the solver on one instance, as written by the harness (one
+    JSON object per line). A results file can be read back as the baseline of a later run.
+*/
+
+#ifndef Glucose_RunRecord_h
+#define Glucose_RunRecord_h
+
+#include <string>
+
+#include "utils/JsonWriter.h"
+#include "utils/PerfCounters.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// RunRecord -- measurements of a run:
+
+struct RunRecord {
+    std::string instance;
+    int         run;
+    uint64_t    seed;
+    std::string status;        // SATISFIABLE, UNSATISFIABLE, INDETERMINATE, TIMEOUT, MEMOUT, ERROR or CRASH.
+    double      wall, cpu;     // In seconds.
+    double      peakMem;       // Peak resident memory in MB.
+    uint64_t    conflicts, propagations, decisions;
+    uint64_t    bddRuns, bddLitsSent, bddClauses;
+    double      bddTime;
+    double      phaseTimes[nbSolverPhases]; // Seconds per phase of the search, written as "time_<phase>".
+
+    RunRecord() : run(0), seed(0), wall(0), cpu(0), peakMem(0), conflicts(0), propagations(0), decisions(0),
+                  bddRuns(0), bddLitsSent(0), bddClauses(0), bddTime(0) {
+        for (int p = 0; p < nbSolverPhases; p++) phaseTimes[p] = 0; }
+
+    bool   solved() const { return status == "SATISFIABLE" || status == "UNSATISFIABLE"; }
+    double conflictsPerSec()    const { return cpu > 0 ? conflicts / cpu : 0; }
+    double propagationsPerSec() const { return cpu > 0 ? propagations / cpu : 0; }
+
+    void write(JsonWriter& json) const;
+
+    // Read the fields of a flat JSON object. Unknown fields are ignored. Returns false on a
+    // malformed line.
+    bool parse(const char* line);
+};
+
+//=================================================================================================
+}
+
+#endif
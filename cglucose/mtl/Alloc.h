@@ -56,6 +56,7 @@ class RegionAllocator
     uint32_t size      () const      { return sz; }
     uint32_t getCap    () const      { return cap;}
     uint32_t wasted    () const      { return wasted_; }
+    void     reserve   (uint32_t n)  { capacity(sz + n); }   // Room for 'n' more units without reallocation.
 
     Ref      alloc     (int size); 
     void     free      (int size)    { wasted_ += size; }
@@ -78,6 +78,7 @@ class Heap {
 
     int  size      ()          const { return heap.size(); }
     bool empty     ()          const { return heap.size() == 0; }
+    uint64_t bytes ()          const { return heap.bytes() + indices.bytes(); }
     bool inHeap    (int n)     const { return n < indices.size() && indices[n] >= 0; }
     int  operator[](int index) const { assert(index < heap.size()); return heap[index]; }
 
@@ -128,6 +129,7 @@ class Heap {
         heap.clear();
 
         for (int i = 0; i < ns.size(); i++){
+            indices.growTo(ns[i]+1, -1);
             indices[ns[i]] = i;
             heap.push(ns[i]); }
 
@@ -40,6 +40,7 @@ public:
 
     void clear (bool dealloc = false) { buf.clear(dealloc); buf.growTo(1); first = end = 0; }
     int  size  () const { return (end >= first) ? end - first : end - first + buf.size(); }
+    uint64_t bytes() const { return buf.bytes(); }
 
     
     
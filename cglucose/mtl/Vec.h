@@ -65,6 +65,7 @@ public:
     void     shrink   (int nelems)     { assert(nelems <= sz); for (int i = 0; i < nelems; i++) sz--, data[sz].~T(); }
     void     shrink_  (int nelems)     { assert(nelems <= sz); sz -= nelems; }
     int      capacity (void) const     { return cap; }
+    uint64_t bytes    (void) const     { return (uint64_t)cap * sizeof(T); } // Heap memory held by the vector.
     void     capacity (int min_cap);
     void     growTo   (int size);
     void     growTo   (int size, const T& pad);
@@ -27,6 +27,20 @@ COPTIMIZE ?= -O3
 CFLAGS    += -I$(MROOT) -D __STDC_LIMIT_MACROS -D __STDC_FORMAT_MACROS
 LFLAGS    += -lz
 
+## Optional decompressors for the input files: eg. "make HAVE_LZMA=1 HAVE_ZSTD=1 HAVE_BZIP2=1"
+ifdef HAVE_LZMA
+CFLAGS    += -D GLUCOSE_HAVE_LZMA
+LFLAGS    += -llzma
+endif
+ifdef HAVE_ZSTD
+CFLAGS    += -D GLUCOSE_HAVE_ZSTD
+LFLAGS    += -lzstd
+endif
+ifdef HAVE_BZIP2
+CFLAGS    += -D GLUCOSE_HAVE_BZIP2
+LFLAGS    += -lbz2
+endif
+
 PYTHON_CFLAGS := -I/usr/include/python3.10
 PYTHON_LDFLAGS := -L/mnt/c/Python311/libs -lpython3.10
 
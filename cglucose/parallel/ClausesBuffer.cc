@@ -85,14 +85,16 @@ ClausesBuffer::ClausesBuffer(int _nbThreads, unsigned int _maxsize) : first(0),
     maxsize(_maxsize), queuesize(0), 
     removedClauses(0),
     forcedRemovedClauses(0), nbThreads(_nbThreads), 
-    whenFullRemoveOlder(opt_whenFullRemoveOlder), fifoSizeByCore(opt_fifoSizeByCore) {
+    whenFullRemoveOlder(opt_whenFullRemoveOlder), fifoSizeByCore(opt_fifoSizeByCore),
+    nbPushed(0), nbPushedLits(0), nbRejected(0), nbFetched(0), nbFetchedLits(0) {
 	lastOfThread.growTo(_nbThreads);
 	for(int i=0;i<nbThreads;i++) lastOfThread[i] = _maxsize-1;
 	elems.growTo(maxsize);
 } 
 
 ClausesBuffer::ClausesBuffer() : first(0), last(0), maxsize(0), queuesize(0), removedClauses(0), forcedRemovedClauses(0), nbThreads(0),
-                                 whenFullRemoveOlder(opt_whenFullRemoveOlder), fifoSizeByCore(opt_fifoSizeByCore) {}
+                                 whenFullRemoveOlder(opt_whenFullRemoveOlder), fifoSizeByCore(opt_fifoSizeByCore),
+                                 nbPushed(0), nbPushedLits(0), nbRejected(0), nbFetched(0), nbFetchedLits(0) {}
 
 void ClausesBuffer::setNbThreads(int _nbThreads) {
     unsigned int _maxsize = fifoSizeByCore*_nbThreads;
@@ -164,8 +166,10 @@ inline uint32_t ClausesBuffer::noCheckPop(uint32_t & index) {
 
 // Return true if the clause was succesfully added
 bool ClausesBuffer::pushClause(int threadId, Clause & c) {
-    if (!whenFullRemoveOlder && (queuesize + c.size() + headerSize >= maxsize))
+    if (!whenFullRemoveOlder && (queuesize + c.size() + headerSize >= maxsize)) {
+	nbRejected++;
 	return false; // We need to remove some old clauses
+    }
     while (queuesize + c.size() + headerSize >= maxsize) { // We need to remove some old clauses
 	forcedRemovedClauses ++;
 	removeLastClause();
@@ -177,6 +181,8 @@ bool ClausesBuffer::pushClause(int threadId, Clause & c) {
     for(int i=0;i<c.size();i++)
 	noCheckPush(toInt(c[i]));
     queuesize += c.size()+headerSize;
+    nbPushed++;
+    nbPushedLits += c.size();
     return true;
     //  printf(" -> (%d, %d)\n", first, last);
 }
@@ -222,6 +228,8 @@ bool ClausesBuffer::getClause(int threadId, int & threadOrigin, vec<Lit> & resul
     for(int i=0;i<csize;i++) {
 	resultClause.push(toLit(noCheckPop(thislast)));
     }
+    nbFetched++;
+    nbFetchedLits += csize;
     if (last == previouslast && removeAfter) {
 	removeLastClause();
 	thislast = last;
@@ -76,6 +76,11 @@ namespace Glucose {
 	vec<unsigned int> lastOfThread; // Last value for a thread 
 
 	public:
+	// Statistics (clause exchange volume):
+	uint64_t  nbPushed, nbPushedLits;   // Clauses (and their literals) added to the FIFO
+	uint64_t  nbRejected;               // Clauses not added because the FIFO was full
+	uint64_t  nbFetched, nbFetchedLits; // Clauses (and their literals) imported by a thread
+
 	ClausesBuffer(int _nbThreads, unsigned int _maxsize);
 	ClausesBuffer();
 
@@ -92,6 +97,8 @@ namespace Glucose {
         bool getClause(int threadId, int & threadOrigin, vec<Lit> & resultClause, bool firstFound = false); 
 	
 	int maxSize() const {return maxsize;}
+	unsigned int nbForcedRemoved() const {return forcedRemovedClauses;}
+	uint64_t bytes() const { return elems.bytes() + lastOfThread.bytes(); }
         uint32_t getCap();
 	void growTo(int size) {
 	    assert(0); // Not implemented (essentially for efficiency reasons)
@@ -51,20 +51,27 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <signal.h>
 #include <zlib.h>
+#include <map>
+#include <string>
 
 
 #include "utils/System.h"
 #include "utils/ParseUtils.h"
 #include "utils/Options.h"
 #include "core/Dimacs.h"
+#include "core/BinaryCnf.h"
 #include "core/SolverTypes.h"
 
 #include "simp/SimpSolver.h"
 #include "parallel/ParallelSolver.h"
 #include "parallel/MultiSolvers.h"
+#include "utils/JsonWriter.h"
 
 using namespace Glucose;
 
+extern IntOption opt_nbsolversmultithreads;
+extern IntOption opt_maxnbsolvers;
+
 
 
 static MultiSolvers* pmsolver;
@@ -73,18 +80,132 @@ static MultiSolvers* pmsolver;
 // for this feature of the Solver as it may take longer than an immediate call to '_exit()'.
 //static void SIGINT_interrupt(int signum) { pmsolver->interrupt(); }
 
+// Ask the running solvers for a statistics snapshot at their next conflict and keep going.
+static void SIGUSR1_snapshot(int signum) { Solver::requestSnapshot(); }
+
 
 // Note that '_exit()' rather than 'exit()' has to be used. The reason is that 'exit()' calls
 // destructors and may cause deadlocks if a malloc/free function happens to be running (these
 // functions are guarded by locks for multithreaded use).
 static void SIGINT_exit(int signum) {
     printf("\n"); printf("*** INTERRUPTED ***\n");
-    if (pmsolver->verbosity() > 0){
+    if (pmsolver != NULL && pmsolver->verbosity() > 0){
         pmsolver->printFinalStats();
         printf("\n"); printf("*** INTERRUPTED ***\n"); }
     _exit(1); }
 
 
+//=================================================================================================
+// Thread scaling benchmark:
+
+
+/*_________________________________________________________________________________________________
+|
+|  runScaling : (files : char**) (nbFiles : int) (outFile : const char*)  ->  [int]
+|
+|  Description:
+|    Solve every instance with 1, 2, 4, ... threads up to '-nthreads' (or '-maxnbthreads' when
+|    it is 0). Each run is written as one JSON line in 'outFile' with its speedup over the run
+|    with one thread, the clause exchange volume through the ClausesBuffer, the contention of
+|    the SharedCompanion locks and the clause arena of every thread. A summary is printed.
+|________________________________________________________________________________________________@*/
+static int runScaling(char** files, int nbFiles, const char* outFile)
+{
+    int maxThreads = opt_nbsolversmultithreads > 0 ? (int)opt_nbsolversmultithreads : (int)opt_maxnbsolvers;
+    vec<int> counts;
+    for (int t = 1; t < maxThreads; t *= 2) counts.push(t);
+    counts.push(maxThreads);
+
+    FILE* out = fopen(outFile, "wb");
+    if (out == NULL)
+        printf("c ERROR! Could not open file: %s\n", outFile), exit(1);
+    JsonWriter json(out);
+
+    std::map<std::string, double> base; // Wall time with one thread
+    printf("c %8s %10s %10s %10s %12s %10s\n", "threads", "wall", "cpu", "speedup", "lock wait", "exported");
+    for (int c = 0; c < counts.size(); c++) {
+        double totalWall = 0, totalCpu = 0, totalBase = 0, totalWait = 0;
+        uint64_t totalExported = 0;
+        for (int f = 0; f < nbFiles; f++) {
+            MultiSolvers* ms = new MultiSolvers();
+            pmsolver = ms;
+            ms->setVerbosity(0);
+            ms->setNbThreads(counts[c]);
+
+            parse_CNF(files[f], *ms);
+
+            double wall = realTime(), cpu = cpuTime();
+            bool ok = ms->simplify();
+            if (ok) ok = ms->eliminate() && ms->okay();
+            lbool ret = ok ? ms->solve() : l_False;
+            wall = realTime() - wall;
+            cpu = cpuTime() - cpu;
+            if (counts[c] == 1) base[files[f]] = wall;
+
+            json.beginObject();
+            json.value("instance", files[f]);
+            json.value("threads", counts[c]);
+            json.value("status", ret == l_True ? "SATISFIABLE" : ret == l_False ? "UNSATISFIABLE" : "INDETERMINATE");
+            json.value("wall", wall);
+            json.value("cpu", cpu);
+            json.value("speedup", base[files[f]] / wall);
+            json.value("mem", memUsed());
+            ms->writeScalingStats(json);
+            json.endObject();
+            json.flush();
+
+            totalWall += wall; totalCpu += cpu; totalBase += base[files[f]];
+            totalWait += ms->lockWaitTime();
+            totalExported += ms->nbExported();
+            delete ms;
+        }
+        printf("c %8d %10.2f %10.2f %10.2f %12.3f %10" PRIu64"\n", counts[c], totalWall, totalCpu, totalBase / totalWall, totalWait, totalExported);
+    }
+    fclose(out);
+    pmsolver = NULL;
+    return 0;
+}
+
+
+//=================================================================================================
+// Statistics:
+
+
+// The result, the statistics of the threads, the clause exchange, the memory high-water mark and
+// the value of every option, as one JSON line.
+static void writeStatsJson(const char* file, MultiSolvers& msolver, const char* instance, lbool ret, double wall)
+{
+    FILE* out = fopen(file, "ab");
+    if (out == NULL) {
+        printf("c ERROR! Could not open file: %s\n", file);
+        return;
+    }
+    JsonWriter json(out);
+    json.beginObject();
+    json.value("instance", instance);
+    json.value("mode", "parallel");
+    json.value("status", ret == l_True ? "SATISFIABLE" : ret == l_False ? "UNSATISFIABLE" : "INDETERMINATE");
+    json.value("cpu_time", cpuTime());
+    json.value("wall_time", wall);
+    json.beginObject("memory");
+    json.value("peak_mb", memUsedPeak());
+    json.value("current_mb", memUsed());
+    json.endObject();
+    msolver.writeThreadStats(json);
+    msolver.writeScalingStats(json);
+    if (ret == l_True && msolver.getShowModel()) {
+        json.beginArray("model");
+        for (int i = 0; i < msolver.model.size(); i++)
+            if (msolver.model[i] != l_Undef)
+                json.value(NULL, msolver.model[i] == l_True ? i + 1 : -(i + 1));
+        json.endArray();
+    }
+    writeOptionsJson(json, "config");
+    json.endObject();
+    fclose(out);
+}
+
+
 //=================================================================================================
 // Main:
 
@@ -94,7 +215,7 @@ int main(int argc, char** argv)
     double realTimeStart = realTime();
   printf("c\nc This is glucose-syrup 4.0 (glucose in many threads) --  based on MiniSAT (Many thanks to MiniSAT team)\nc\n");
     try {
-        setUsageHelp("c USAGE: %s [options] <input-file> <result-output-file>\n\n  where input may be either in plain or gzipped DIMACS.\n");
+        setUsageHelp("c USAGE: %s [options] <input-file> <result-output-file>\n\n  where input may be plain, gzipped, xz, zstd or bzip2 compressed DIMACS.\n");
         // printf("This is MiniSat 2.0 beta\n");
         
 #if defined(__linux__)
@@ -109,9 +230,19 @@ int main(int argc, char** argv)
         IntOption    vv  ("MAIN", "vv",   "Verbosity every vv conflicts", 10000, IntRange(1,INT32_MAX));
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+        BoolOption   scaling("MAIN", "scaling", "Thread scaling benchmark: solve the input files with 1, 2, 4... up to nthreads threads.", false);
+        StringOption scaling_out("MAIN", "scaling-out", "File receiving the report of the scaling benchmark (JSON lines).", "scaling.json");
+        StringOption stats_json("MAIN", "stats-json", "If given, append the result and the statistics of the run to this file (JSON lines).");
         
         parseOptions(argc, argv, true);
 
+        if (scaling) {
+            if (argc == 1)
+                printf("c ERROR! The scaling benchmark needs input files\n"), exit(1);
+            signal(SIGINT, SIGINT_exit);
+            return runScaling(argv + 1, argc - 1, scaling_out);
+        }
+
 	MultiSolvers msolver;
         pmsolver = & msolver;
         msolver.setVerbosity(verb);
@@ -149,16 +280,20 @@ int main(int argc, char** argv)
         if (argc == 1)
             printf("c Reading from standard input... Use '--help' for help.\n");
         
-        gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
-        if (in == NULL)
+        bool binary = argc > 1 && isBinaryCnf(argv[1]);
+        InputStream* in = binary ? NULL : InputStream::open(argc == 1 ? NULL : argv[1]);
+        if (!binary && in == NULL)
             printf("c ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
         
         if (msolver.verbosity() > 0){
             printf("c ========================================[ Problem Statistics ]===========================================\n");
             printf("c |                                                                                                       |\n"); }
         
-        parse_DIMACS(in, msolver);
-        gzclose(in);
+        if (binary) {
+            if (load_BinaryCnf(argv[1], msolver) < 0) exit(1);
+        } else {
+            parse_DIMACS(*in, msolver);
+            delete in; }
         
 
 	
@@ -177,6 +312,7 @@ int main(int argc, char** argv)
         // voluntarily:
         //signal(SIGINT, SIGINT_interrupt);
         //signal(SIGXCPU,SIGINT_interrupt);
+        signal(SIGUSR1,SIGUSR1_snapshot);
  
         
 	int ret2 = msolver.simplify();    	
@@ -197,6 +333,8 @@ int main(int argc, char** argv)
 		printf("c cpu time  : %g s\n", cpuTime());
                 printf("\n"); }
             printf("s UNSATISFIABLE\n");
+            if (stats_json)
+                writeStatsJson(stats_json, msolver, argc == 1 ? "<stdin>" : argv[1], l_False, realTime() - realTimeStart);
             exit(20);
         }
 
@@ -230,6 +368,9 @@ int main(int argc, char** argv)
         } else { 
 	*/
 	  printf(ret == l_True ? "s SATISFIABLE\n" : ret == l_False ? "s UNSATISFIABLE\n" : "s INDETERMINATE\n");
+
+	  if (stats_json)
+	      writeStatsJson(stats_json, msolver, argc == 1 ? "<stdin>" : argv[1], ret, realTime() - realTimeStart);
 	  
 	  if(msolver.getShowModel() && ret==l_True) {
 	    printf("v ");
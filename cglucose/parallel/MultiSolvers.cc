@@ -61,8 +61,10 @@ using namespace Glucose;
 extern const char* _parallel ;
 extern const char* _cunstable;
 // Options at the parallel solver level
-static IntOption opt_nbsolversmultithreads (_parallel, "nthreads", "Number of core threads for syrup (0 for automatic)", 0);
-static IntOption opt_maxnbsolvers (_parallel, "maxnbthreads", "Maximum number of core threads to ask for (when nbthreads=0)", 4);
+// Shared with Main.cc (scaling benchmark)
+IntOption opt_nbsolversmultithreads (_parallel, "nthreads", "Number of core threads for syrup (0 for automatic)", 0);
+IntOption opt_maxnbsolvers (_parallel, "maxnbthreads", "Maximum number of core threads to ask for (when nbthreads=0)", 4);
+//
 static IntOption opt_maxmemory    (_parallel, "maxmemory", "Maximum memory to use (in Mb, 0 for no software limit)", 3000);
 static IntOption opt_statsInterval (_parallel, "statsinterval", "Seconds (real time) between two stats reports", 5);
 //
@@ -134,8 +136,23 @@ MultiSolvers::MultiSolvers() : MultiSolvers(new ParallelSolver(-1)) {
 
 }
 
+// Takes the ownership of the solvers (including the one given to the constructor)
 MultiSolvers::~MultiSolvers()
-{}
+{
+    for (int i = 0; i < solvers.size(); i++)
+	delete solvers[i];
+    for (int i = 0; i < threads.size(); i++)
+	free(threads[i]);
+    delete sharedcomp;
+    pthread_mutex_destroy(&m);
+    pthread_mutex_destroy(&mfinished);
+    pthread_cond_destroy(&cfinished);
+}
+
+void MultiSolvers::setNbThreads(int n) {
+    assert(allClonesAreBuilt == 0);
+    nbthreads = nbsolvers = n;
+}
 
 /**
  * Generate All solvers
@@ -186,6 +203,18 @@ Var MultiSolvers::newVar(bool sign, bool dvar)
   return numvar;
 }
 
+void MultiSolvers::beginBulkLoad(int nb_vars, uint64_t nb_clauses, uint64_t nb_lits)
+{
+  for (int i = 0; i < (allClonesAreBuilt ? nbsolvers : 1); i++)
+    solvers[i]->beginBulkLoad(nb_vars, nb_clauses, nb_lits);
+}
+
+void MultiSolvers::endBulkLoad()
+{
+  for (int i = 0; i < (allClonesAreBuilt ? nbsolvers : 1); i++)
+    solvers[i]->endBulkLoad();
+}
+
 bool MultiSolvers::addClause_(vec<Lit>&ps) {
   assert(solvers[0] != NULL); // There is at least one solver.
   // Check if clause is satisfied and remove false/duplicate literals:
@@ -257,7 +286,8 @@ bool MultiSolvers::eliminate() {
 void *localLaunch(void*arg) {
   ParallelSolver* s = (ParallelSolver*)arg;
   
-  (void)s->solve();
+  s->budgetOff();
+  (void)s->solve_();
   
   pthread_exit(NULL);
 }
@@ -409,6 +439,14 @@ void MultiSolvers::printFinalStats() {
     }
     printf("|                 |\n"); 
 
+    printf("c | Peak MB       ");
+    double peakMem = 0;
+    for(int i=0;i<solvers.size();i++) {
+	printf("| %10.2f ", solvers[i]->memAccount.totalPeak() / 1048576.0);
+        peakMem += solvers[i]->memAccount.totalPeak() / 1048576.0;
+    }
+    printf("| %15.2f |\n", peakMem);
+
 
     int winner = -1;
    for(int i=0;i<solvers.size();i++) {
@@ -444,6 +482,80 @@ int sum = 0;
 
 }
 
+static void writeLockStats(JsonWriter& json, const char* key, const SharedCompanion::LockStats& st) {
+    json.beginObject(key);
+    json.value("acquisitions", st.acquisitions);
+    json.value("contended", st.contended);
+    json.value("wait", st.wait);
+    json.endObject();
+}
+
+// Writes the fields in the current object of 'json'. The memory of a thread is the capacity of
+// its clause arena (the largest per-thread structure).
+void MultiSolvers::writeScalingStats(JsonWriter& json) {
+    const ClausesBuffer& cb = sharedcomp->clausesBuffer;
+    json.beginObject("exchange");
+    json.value("pushed", cb.nbPushed);
+    json.value("pushedLits", cb.nbPushedLits);
+    json.value("rejected", cb.nbRejected);
+    json.value("dropped", (uint64_t)cb.nbForcedRemoved());
+    json.value("fetched", cb.nbFetched);
+    json.value("fetchedLits", cb.nbFetchedLits);
+    json.value("buffer_bytes", cb.bytes());
+    json.endObject();
+
+    json.beginObject("locks");
+    writeLockStats(json, "clauses", sharedcomp->clauseLockStats);
+    writeLockStats(json, "units", sharedcomp->unitLockStats);
+    writeLockStats(json, "job", sharedcomp->jobLockStats);
+    json.endObject();
+
+    json.beginArray("solvers");
+    for (int i = 0; i < solvers.size(); i++) {
+	ParallelSolver* s = solvers[i];
+	json.beginObject();
+	json.value("conflicts", s->conflicts);
+	json.value("propagations", s->propagations);
+	json.value("exported", s->nbexported);
+	json.value("imported", s->nbimported);
+	json.value("learnts", s->nLearnts());
+	json.value("arenaBytes", (uint64_t)s->ca.getCap() * ClauseAllocator::Unit_Size);
+	json.endObject();
+    }
+    json.endArray();
+}
+
+void MultiSolvers::writeThreadStats(JsonWriter& json) {
+    json.beginArray("threads");
+    for (int i = 0; i < solvers.size(); i++) {
+	ParallelSolver* s = solvers[i];
+	json.beginObject();
+	json.value("thread", i);
+	json.value("winner", sharedcomp->winner() == s);
+	s->writeStats(json);
+	json.value("exported", s->nbexported);
+	json.value("imported", s->nbimported);
+	json.value("imported_good", s->nbImportedGoodClauses);
+	json.value("imported_purgatory", s->nbimportedInPurgatory);
+	json.value("exported_units", s->nbexportedunit);
+	json.value("imported_units", s->nbimportedunit);
+	json.value("blocked_reuse", s->nbNotExportedBecauseDirectlyReused);
+	json.endObject();
+    }
+    json.endArray();
+}
+
+double MultiSolvers::lockWaitTime() {
+    return sharedcomp->clauseLockStats.wait + sharedcomp->unitLockStats.wait + sharedcomp->jobLockStats.wait;
+}
+
+uint64_t MultiSolvers::nbExported() {
+    uint64_t exported = 0;
+    for (int i = 0; i < solvers.size(); i++)
+	exported += solvers[i]->nbexported;
+    return exported;
+}
+
 // Well, all those parameteres are just naive guesses... No experimental evidences for this.
 void MultiSolvers::adjustParameters() {
     SolverConfiguration::configure(this,nbsolvers);
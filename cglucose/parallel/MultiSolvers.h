@@ -51,6 +51,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #define MultiSolvers_h
 
 #include "parallel/ParallelSolver.h"
+#include "utils/JsonWriter.h"
 
 namespace Glucose {
     class SolverConfiguration;
@@ -64,10 +65,15 @@ public:
   ~MultiSolvers();
  
   void printFinalStats(); 
+  void writeScalingStats(JsonWriter& json); // Clause exchange, lock contention and per-thread memory (after solve())
+  void writeThreadStats(JsonWriter& json);  // Statistics of every thread, as an array "threads"
+  double lockWaitTime();                    // Time spent waiting for the SharedCompanion locks (all threads)
+  uint64_t nbExported();                    // Clauses exported by all threads
 
   void setVerbosity(int i);
   int verbosity();
   void setVerbEveryConflicts(int i);
+  void setNbThreads(int n);          // Number of solvers (0 for automatic), must be called before solve()
   void setShowModel(int i) {showModel = i;}
   int getShowModel() {return showModel;}
   // Problem specification:
@@ -75,6 +81,8 @@ public:
   Var     newVar    (bool polarity = true, bool dvar = true); // Add a new variable with parameters specifying variable mode.
   bool    addClause (const vec<Lit>& ps);                           // Add a clause to the solver. NOTE! 'ps' may be shrunk by this method!
   bool    addClause_(      vec<Lit>& ps);       
+  void    beginBulkLoad(int nb_vars, uint64_t nb_clauses, uint64_t nb_lits); // Pre-size the solvers built so far.
+  void    endBulkLoad  ();
   
   bool    simplify     ();                        // Removes already satisfied clauses.
   
@@ -78,6 +78,8 @@ ParallelSolver::ParallelSolver(int threadId) :
 , nbNotExportedBecauseDirectlyReused(0)
 {
     useUnaryWatched = true; // We want to use promoted clauses here !
+    perfCounters = false; // Counters are opened per thread by the sequential solver only
+    checkpointFile = NULL; // Checkpoints are written by the sequential solver only
 }
 
 
@@ -142,6 +144,7 @@ struct reduceDB_oneWatched_lt {
 
 // @overide
 void ParallelSolver::reduceDB() {
+    PhaseScope phase(*this, phaseReduceDB);
 
     int i, j;
     nbReduceDB++;
@@ -250,6 +253,17 @@ void ParallelSolver::reportProgress() {
     //printf("c thread=%d confl=%lld starts=%llu reduceDB=%llu learnts=%d broadcast=%llu  blockedReuse=%lld imported=%llu promoted=%llu limitlbd=%llu limitsize=%llu\n", thn, conflicts, starts, nbReduceDB, learnts.size(), nbexported, nbNotExportedBecauseDirectlyReused, nbimported, nbPromoted, goodlimitlbd, goodlimitsize);
 }
 
+void ParallelSolver::writeSnapshot(JsonWriter& json) {
+    json.value("thread", thn);
+    json.value("exported", nbexported);
+    json.value("imported", nbimported);
+    json.value("imported_purgatory", nbimportedInPurgatory);
+    json.value("exported_units", nbexportedunit);
+    json.value("imported_units", nbimportedunit);
+    json.value("good_lbd_limit", (int)goodlimitlbd);
+    SimpSolver::writeSnapshot(json);
+}
+
 void ParallelSolver::reportProgressArrayImports(vec<unsigned int> &totalColumns) {
     return ; // TODO : does not currently work
     unsigned int totalImports = 0;
@@ -439,6 +453,7 @@ lbool ParallelSolver::solve_(bool do_simp, bool turn_off_simp) {
     if (!ok) return l_False;
 
     solves++;
+    PhaseScope searchPhase(*this, phaseSearch);
 
 
     lbool status = l_Undef;
@@ -97,6 +97,7 @@ public:
     void reportProgressArrayImports(vec<unsigned int> &totalColumns);
     virtual void reduceDB();
     virtual lbool         solve_                   (bool do_simp = true, bool turn_off_simp = false);
+    virtual void writeSnapshot(JsonWriter& json);
 
     vec<Lit>    importedClause; // Temporary clause used to copy each imported clause
     uint64_t    nbexported;
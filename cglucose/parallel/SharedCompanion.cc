@@ -47,6 +47,8 @@ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
 OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  **************************************************************************************************/
 
+#include <time.h>
+
 #include "core/Solver.h"
 #include "parallel/ParallelSolver.h"
 #include "core/SolverTypes.h"
@@ -75,19 +77,37 @@ SharedCompanion::SharedCompanion(int _nbThreads) :
 
 }
 
+SharedCompanion::~SharedCompanion() {
+	pthread_mutex_destroy(&mutexSharedClauseCompanion);
+	pthread_mutex_destroy(&mutexSharedUnitCompanion);
+	pthread_mutex_destroy(&mutexSharedCompanion);
+	pthread_mutex_destroy(&mutexJobFinished);
+}
+
+void SharedCompanion::lock(pthread_mutex_t* mu, LockStats& stats) {
+    if (pthread_mutex_trylock(mu) != 0) {
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pthread_mutex_lock(mu);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	stats.contended++; // Updated under the lock
+	stats.wait += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+    }
+    stats.acquisitions++;
+}
+
 void SharedCompanion::setNbThreads(int _nbThreads) {
    nbThreads = _nbThreads;
    clausesBuffer.setNbThreads(_nbThreads); 
 }
 
 void SharedCompanion::printStats() {
+    printf("c shared clause buffer  : %.2f MB\n", clausesBuffer.bytes() / 1048576.0);
 }
 
 // No multithread safe
 bool SharedCompanion::addSolver(ParallelSolver* s) {
 	watchedSolvers.push(s);
-	pthread_mutex_t* mu = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t));
-	pthread_mutex_init(mu,NULL);
 	assert(s->thn == watchedSolvers.size()-1); // all solvers must have been registered in the good order
 	nextUnit.push(0);
 
@@ -98,7 +118,7 @@ void SharedCompanion::newVar(bool sign) {
 }
 
 void SharedCompanion::addLearnt(ParallelSolver *s,Lit unary) {
-  pthread_mutex_lock(&mutexSharedUnitCompanion);
+  lock(&mutexSharedUnitCompanion, unitLockStats);
   if (isUnary[var(unary)]==l_Undef) {
       unitLit.push(unary);
       isUnary[var(unary)] = sign(unary)?l_False:l_True;
@@ -110,7 +130,7 @@ Lit SharedCompanion::getUnary(ParallelSolver *s) {
   int sn = s->thn;
   Lit ret = lit_Undef;
 
-  pthread_mutex_lock(&mutexSharedUnitCompanion);
+  lock(&mutexSharedUnitCompanion, unitLockStats);
   if (nextUnit[sn] < unitLit.size())
       ret = unitLit[nextUnit[sn]++];
   pthread_mutex_unlock(&mutexSharedUnitCompanion);
@@ -125,7 +145,7 @@ bool SharedCompanion::addLearnt(ParallelSolver *s, Clause & c) {
   bool ret = false;
   assert(watchedSolvers.size()>sn);
 
-  pthread_mutex_lock(&mutexSharedClauseCompanion);
+  lock(&mutexSharedClauseCompanion, clauseLockStats);
   ret = clausesBuffer.pushClause(sn, c);
   pthread_mutex_unlock(&mutexSharedClauseCompanion);
   return ret;
@@ -136,7 +156,7 @@ bool SharedCompanion::getNewClause(ParallelSolver *s, int & threadOrigin, vec<Li
   int sn = s->thn;
   
     // First, let's get the clauses on the big blackboard
-    pthread_mutex_lock(&mutexSharedClauseCompanion);
+    lock(&mutexSharedClauseCompanion, clauseLockStats);
     bool b = clausesBuffer.getClause(sn, threadOrigin, newclause);
     pthread_mutex_unlock(&mutexSharedClauseCompanion);
  
@@ -145,7 +165,7 @@ bool SharedCompanion::getNewClause(ParallelSolver *s, int & threadOrigin, vec<Li
 
 bool SharedCompanion::jobFinished() {
     bool ret = false;
-    pthread_mutex_lock(&mutexJobFinished);
+    lock(&mutexJobFinished, jobLockStats);
     ret = bjobFinished;
     pthread_mutex_unlock(&mutexJobFinished);
     return ret;
@@ -153,7 +173,7 @@ bool SharedCompanion::jobFinished() {
 
 bool SharedCompanion::IFinished(ParallelSolver *s) {
     bool ret = false;
-    pthread_mutex_lock(&mutexJobFinished);
+    lock(&mutexJobFinished, jobLockStats);
     if (!bjobFinished) {
 	ret = true;
 	bjobFinished = true;
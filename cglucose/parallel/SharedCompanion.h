@@ -73,6 +73,7 @@ public:
 	void newVar(bool sign);            // Adds a var (used to keep track of unary variables)
 	void printStats();                 // Printing statistics of all solvers
 
+	~SharedCompanion();
 	bool jobFinished();                // True if the job is over
 	bool IFinished(ParallelSolver *s); // returns true if you are the first solver to finish
 	bool addSolver(ParallelSolver*);   // attach a solver to accompany 
@@ -83,8 +84,19 @@ public:
 	Lit getUnary(ParallelSolver *s);                              // Gets a new unary literal
 	inline ParallelSolver* winner(){return jobFinishedBy;}        // Gets the first solver that called IFinished()
 
+	// Contention of a mutex: a lock is contended when it could not be taken immediately, the
+	// time spent waiting for it is only measured in this case.
+	struct LockStats {
+	    uint64_t acquisitions, contended;
+	    double   wait;                     // Seconds (real time)
+	    LockStats() : acquisitions(0), contended(0), wait(0) {}
+	};
+	LockStats clauseLockStats, unitLockStats, jobLockStats;
+
  protected:
 
+	void lock(pthread_mutex_t* mu, LockStats& stats); // Lock and update the contention statistics
+
 	ClausesBuffer clausesBuffer; // A big blackboard for all threads sharing non unary clauses
 	int nbThreads;               // Number of threads
 	
@@ -0,0 +1,311 @@
+/*
+    Backbone computation with parallel incremental solvers.
+    See Backbone.h
+*/
+
+#include <thread>
+
+#include "utils/System.h"
+#include "simp/Backbone.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Options:
+
+
+static const char* _cat = "BACKBONE";
+
+static IntOption opt_bb_threads   (_cat, "bb-threads",    "Number of solver clones testing the backbone candidates", 4, IntRange(1, 256));
+static IntOption opt_bb_share_lbd (_cat, "bb-share-lbd",  "Max LBD of the learnt clauses shared between the clones", 2, IntRange(0, INT32_MAX));
+static IntOption opt_bb_share_size(_cat, "bb-share-size", "Max size of the learnt clauses shared between the clones", 30, IntRange(0, INT32_MAX));
+
+
+//=================================================================================================
+// BackboneWorker:
+
+
+BackboneWorker::BackboneWorker(const SimpSolver& s, Backbone& b, int i) :
+    SimpSolver (s)
+  , nbTests    (0)
+  , nbProved   (0)
+  , nbImported (0)
+  , nbExported (0)
+  , bb         (b)
+  , id         (i)
+  , testing    (-1)
+  , nextClause (0)
+  , nextUnit   (0)
+  , unitsSeen  (trail.size())
+{
+    verbosity = 0;
+}
+
+
+// Report the new units at level 0 (called between two tests, at level 0).
+void BackboneWorker::reportUnits()
+{
+    for (; unitsSeen < trail.size(); unitsSeen++)
+        bb.foundUnit(trail[unitsSeen]);
+}
+
+
+void BackboneWorker::parallelImportUnaryClauses()
+{
+    std::lock_guard<std::mutex> lock(bb.poolMutex);
+    for (; nextUnit < bb.sharedUnits.size(); nextUnit++) {
+        Lit p = bb.sharedUnits[nextUnit];
+        if (value(p) == l_Undef) {
+            uncheckedEnqueue(p);
+            nbImported++;
+        }
+    }
+}
+
+
+// Import the clauses shared by the other clones, without their false literals. Returns true if
+// the empty clause was received.
+bool BackboneWorker::parallelImportClauses()
+{
+    assert(decisionLevel() == 0);
+    std::lock_guard<std::mutex> lock(bb.poolMutex);
+    for (; nextClause < bb.sharedClauses.size(); nextClause++) {
+        if (bb.sharedFrom[nextClause] == id) continue;
+        const std::vector<Lit>& c = bb.sharedClauses[nextClause];
+        bool sat = false;
+        importedClause.clear();
+        for (size_t i = 0; i < c.size() && !sat; i++)
+            if (value(c[i]) == l_True) sat = true;
+            else if (value(c[i]) == l_Undef) importedClause.push(c[i]);
+        if (sat) continue;
+
+        nbImported++;
+        if (importedClause.size() == 0) return true;
+        if (importedClause.size() == 1) {
+            uncheckedEnqueue(importedClause[0]);
+            continue;
+        }
+        CRef cr = ca.alloc(importedClause, true, true);
+        ca[cr].setLBD(importedClause.size());
+        ca[cr].setOneWatched(false);
+        ca[cr].setSizeWithoutSelectors(importedClause.size());
+        learnts.push(cr);
+        attachClause(cr);
+    }
+    return false;
+}
+
+
+void BackboneWorker::parallelExportUnaryClause(Lit p)
+{
+    {
+        std::lock_guard<std::mutex> lock(bb.poolMutex);
+        bb.sharedUnits.push_back(p);
+    }
+    nbExported++;
+    bb.foundUnit(p);
+}
+
+
+void BackboneWorker::parallelExportClauseDuringSearch(Clause& c)
+{
+    if (c.lbd() > bb.shareLBD || c.size() > bb.shareSize) return;
+    std::lock_guard<std::mutex> lock(bb.poolMutex);
+    bb.sharedClauses.push_back(std::vector<Lit>());
+    for (int i = 0; i < c.size(); i++) bb.sharedClauses.back().push_back(c[i]);
+    bb.sharedFrom.push_back(id);
+    nbExported++;
+}
+
+
+//=================================================================================================
+// Backbone:
+
+
+Backbone::Backbone(SimpSolver& s) :
+    nbThreads     (opt_bb_threads)
+  , shareLBD      (opt_bb_share_lbd)
+  , shareSize     (opt_bb_share_size)
+  , nbCandidates  (0)
+  , nbBackbone    (0)
+  , nbFixedAtZero (0)
+  , nbProved      (0)
+  , nbFiltered    (0)
+  , nbTests       (0)
+  , nbShared      (0)
+  , S             (s)
+  , ordering      (NULL)
+  , next          (0)
+  , stopped       (false)
+  , nbWorkers     (0)
+{}
+
+
+Backbone::~Backbone()
+{
+    for (size_t i = 0; i < workers.size(); i++) delete workers[i];
+}
+
+
+// Stop the computation: the search of the first call, and those of the clones (async signal safe,
+// the clones are only visited once they are all built).
+void Backbone::interrupt()
+{
+    stopped = true;
+    S.interrupt();
+    for (int t = 0; t < nbWorkers; t++) workers[t]->interrupt();
+}
+
+
+// Decide candidate 'i' once. A clone testing a candidate which was just filtered out is
+// interrupted.
+bool Backbone::decide(int i, char st)
+{
+    char expected = Undecided;
+    if (!state[i].compare_exchange_strong(expected, st)) return false;
+    if (st == Rejected)
+        for (size_t w = 0; w < workers.size(); w++)
+            if (workers[w]->testing == i) workers[w]->interrupt();
+    return true;
+}
+
+
+void Backbone::filter(const vec<lbool>& model)
+{
+    for (size_t i = 0; i < candidates.size(); i++)
+        if (state[i] == Undecided && (model[var(candidates[i])] ^ sign(candidates[i])) == l_False)
+            decide(i, Rejected);
+}
+
+
+void Backbone::foundUnit(Lit p)
+{
+    if (var(p) >= (int)candidateOf.size()) return;
+    int i = candidateOf[var(p)];
+    if (i >= 0 && candidates[i] == p) decide(i, InBackbone);
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  work : (w : BackboneWorker*)  ->  [void]
+|
+|  Description:
+|    Main loop of a clone: take the next candidate 'l' and test it under the assumption ~l until
+|    it is decided. An interrupted call means that another clone filtered the candidate out, or
+|    that the computation is stopped (see 'interrupt'). A call which runs out of its budget stops
+|    the computation.
+|________________________________________________________________________________________________@*/
+void Backbone::work(BackboneWorker* w)
+{
+    vec<Lit> assumps;
+    size_t i;
+    while (!stopped && (i = next++) < candidates.size()) {
+        while (!stopped && state[i] == Undecided) {
+            w->testing = i;
+            w->clearInterrupt();
+            // 'interrupt' sets 'stopped' before interrupting the clones: a stop cleared above is seen here
+            if (stopped || state[i] != Undecided) break;
+
+            assumps.clear();
+            assumps.push(~candidates[i]);
+            w->nbTests++;
+            // The BDD side works on one ordering at a time: only the first clone calls it
+            lbool ret = w->solveLimited(w->id == 0 ? ordering : NULL, assumps);
+            w->testing = -1;
+            w->reportUnits();
+
+            if (ret == l_True)
+                filter(w->model);
+            else if (ret == l_False) {
+                // An empty conflict means that the call failed without using the assumption
+                if (w->conflict.size() == 0) { stopped = true; break; }
+                if (decide(i, InBackbone)) w->nbProved++;
+                w->addClause(candidates[i]);
+                w->parallelExportUnaryClause(candidates[i]);
+            } else if (!w->asynch_interrupt) {
+                // Out of budget: the test would fail again
+                stopped = true;
+                break;
+            }
+        }
+    }
+    w->testing = -1;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  compute : (bdd_var_ordering : BddVarOrdering*) (out : vec<Lit>&) (nbVars : int)  ->  [lbool]
+|
+|  Description:
+|    Get a first model, take its literals as candidates (those fixed at level 0 are already in
+|    the backbone) and let the clones decide the others.
+|________________________________________________________________________________________________@*/
+lbool Backbone::compute(BddVarOrdering* bdd_var_ordering, vec<Lit>& out, int nbVars)
+{
+    out.clear();
+    if (nbVars < 0 || nbVars > S.nVars()) nbVars = S.nVars();
+    if (S.certifiedUNSAT) {
+        fprintf(stderr, "c Can not compute the backbone with certified UNSAT\n");
+        exit(-1);
+    }
+    if (S.eliminated_vars > 0) {
+        fprintf(stderr, "c Can not compute the backbone after variable elimination (use -no-elim)\n");
+        return l_Undef;
+    }
+    ordering = bdd_var_ordering;
+    stopped = false;
+
+    vec<Lit> dummy;
+    lbool ret = S.solveLimited(bdd_var_ordering, dummy);
+    if (ret != l_True) return ret;
+
+    candidates.clear();
+    candidateOf.assign(S.nVars(), -1);
+    for (Var v = 0; v < nbVars; v++) {
+        if (S.model[v] == l_Undef) continue;
+        candidateOf[v] = candidates.size();
+        candidates.push_back(mkLit(v, S.model[v] == l_False));
+    }
+    nbCandidates = candidates.size();
+    state.reset(new std::atomic<char>[candidates.size()]);
+    for (size_t i = 0; i < candidates.size(); i++) state[i] = Undecided;
+
+    // Units at level 0 are in the backbone for free
+    for (int i = 0; i < S.trail.size(); i++)
+        if (candidateOf[var(S.trail[i])] >= 0 && decide(candidateOf[var(S.trail[i])], InBackbone))
+            nbFixedAtZero++;
+
+    // The clones are copied one after the other, before any thread starts
+    int n = std::max(1, std::min(nbThreads, (int)candidates.size()));
+    for (int t = 0; t < n; t++)
+        workers.push_back(new BackboneWorker(S, *this, t));
+    nbWorkers = n;
+    next = 0;
+    if (stopped) return l_Undef;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n; t++)
+        threads.push_back(std::thread(&Backbone::work, this, workers[t]));
+    for (int t = 0; t < n; t++)
+        threads[t].join();
+
+    for (size_t t = 0; t < workers.size(); t++) {
+        nbTests  += workers[t]->nbTests;
+        nbProved += workers[t]->nbProved;
+    }
+    nbShared = sharedClauses.size();
+    for (size_t i = 0; i < candidates.size(); i++)
+        if (state[i] == InBackbone) out.push(candidates[i]), nbBackbone++;
+        else if (state[i] == Rejected) nbFiltered++;
+
+    return stopped ? l_Undef : l_True;
+}
+
+
+void Backbone::printStats() const
+{
+    printf("c backbone              : %" PRIu64" literals (%" PRIu64" candidates, %" PRIu64" fixed at level 0, %" PRIu64" proved by a test)\n", nbBackbone, nbCandidates, nbFixedAtZero, nbProved);
+    printf("c filtered by models    : %" PRIu64"\n", nbFiltered);
+    printf("c backbone tests        : %" PRIu64" (%d clones, %" PRIu64" shared clauses, %" PRIu64" shared units)\n", nbTests, (int)workers.size(), nbShared, (uint64_t)sharedUnits.size());
+}
@@ -0,0 +1,109 @@
+/*
+    Backbone computation: the literals which are true in every model of the formula.
+
+    The solver is first called once to get a model: its literals are the candidates. Candidates
+    are then tested in parallel by clones of the solver (built with the copy constructor, so they
+    start with the learnt clauses of the first call), each candidate 'l' with an incremental call
+    under the assumption ~l. An unsatisfiable call proves 'l', a satisfiable one gives a new model
+    which filters out every candidate it falsifies. Units found at level 0 by any clone are
+    backbone literals for free, and the clones share them together with their glue clauses
+    through the parallel hooks of the solver. The BDD side is only called by the first call and
+    by the first clone: its variable ordering can not be shared between threads.
+
+    Variable elimination must be turned off (see 'use_elim'): eliminated variables can not be
+    tested under assumptions.
+*/
+
+#ifndef Glucose_Backbone_h
+#define Glucose_Backbone_h
+
+#include "simp/SimpSolver.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Glucose {
+
+class Backbone;
+
+//=================================================================================================
+// BackboneWorker -- a clone of the solver which tests candidates:
+
+class BackboneWorker : public SimpSolver {
+    friend class Backbone;
+public:
+    BackboneWorker(const SimpSolver& s, Backbone& b, int id);
+
+    // Statistics:
+    uint64_t nbTests, nbProved, nbImported, nbExported;
+
+protected:
+    Backbone&        bb;
+    int              id;
+    std::atomic<int> testing;     // Index of the candidate under test (-1 if none).
+    size_t           nextClause;  // First clause of the shared pool not imported yet.
+    size_t           nextUnit;    // First unit of the shared pool not imported yet.
+    int              unitsSeen;   // Prefix of the trail at level 0 already reported.
+    vec<Lit>         importedClause;
+
+    void         reportUnits();
+    virtual void parallelImportUnaryClauses();
+    virtual bool parallelImportClauses();
+    virtual void parallelExportUnaryClause(Lit p);
+    virtual void parallelExportClauseDuringSearch(Clause& c);
+};
+
+//=================================================================================================
+// Backbone -- computes the backbone of the formula stored in a solver:
+
+class Backbone {
+    friend class BackboneWorker;
+public:
+    Backbone(SimpSolver& s);
+    ~Backbone();
+
+    // Compute the backbone over the first 'nbVars' variables (-1 means all variables of the
+    // solver). Returns l_True and the backbone in 'out', l_False if the formula is unsatisfiable,
+    // or l_Undef if the computation was interrupted.
+    lbool compute(BddVarOrdering* bdd_var_ordering, vec<Lit>& out, int nbVars = -1);
+    void  interrupt();          // Stops 'compute' (async signal safe).
+    void  printStats() const;
+
+    // Parameters:
+    int          nbThreads;
+    unsigned int shareLBD;    // Learnt clauses with an LBD up to this value are shared.
+    int          shareSize;   // Learnt clauses with a size up to this value are shared.
+
+    // Statistics:
+    uint64_t nbCandidates, nbBackbone, nbFixedAtZero, nbProved, nbFiltered, nbTests, nbShared;
+
+protected:
+    enum { Undecided = 0, InBackbone = 1, Rejected = 2 };
+
+    SimpSolver&                         S;
+    BddVarOrdering*                     ordering;     // Used by the first clone only.
+    std::vector<Lit>                    candidates;
+    std::vector<int>                    candidateOf;  // Index of the candidate of each variable (-1 if none).
+    std::unique_ptr<std::atomic<char>[]> state;
+    std::atomic<size_t>                 next;         // Next candidate to hand out.
+    std::atomic<bool>                   stopped;
+    std::vector<BackboneWorker*>        workers;
+    std::atomic<int>                    nbWorkers;    // Clones fully built, seen by 'interrupt'.
+
+    // Shared pool:
+    std::mutex                          poolMutex;
+    std::vector<std::vector<Lit> >      sharedClauses;
+    std::vector<int>                    sharedFrom;
+    std::vector<Lit>                    sharedUnits;
+
+    bool  decide(int i, char st);
+    void  filter(const vec<lbool>& model);
+    void  foundUnit(Lit p);
+    void  work(BackboneWorker* w);
+};
+
+//=================================================================================================
+}
+
+#endif
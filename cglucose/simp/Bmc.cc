@@ -0,0 +1,234 @@
+/*
+    Bounded model checking of AIGER circuits.
+    See Bmc.h
+*/
+
+#include <dlfcn.h>
+#include <iostream>
+
+#include "utils/System.h"
+#include "simp/Bmc.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Options:
+
+
+static const char* _cat = "BMC";
+
+static IntOption  opt_bmc_bound (_cat, "bmc-bound",  "Max number of transitions unrolled by the bounded model checking", 100, IntRange(0, INT32_MAX));
+static BoolOption opt_bmc_order (_cat, "bmc-order",  "Hand the gates of the unrolling to the BDD side for its variable ordering", true);
+
+
+//=================================================================================================
+// Constructor/Destructor:
+
+
+Bmc::Bmc(SimpSolver& s, const Aiger& a) :
+    maxBound      (opt_bmc_bound)
+  , gateOrdering  (opt_bmc_order)
+  , bound         (-1)
+  , badProperty   (-1)
+  , nbGates       (0)
+  , nbClauses     (0)
+  , nbSolverCalls (0)
+  , S             (s)
+  , aig           (a)
+  , rust_lib      (NULL)
+  , ordering      (NULL)
+{
+    S.use_elim = false;
+    S.eliminate(true);
+    S.setIncrementalMode();
+    constTrue = mkLit(S.newVar());
+    addClause(constTrue);
+    computeCoi();
+}
+
+
+Bmc::~Bmc()
+{
+    if (rust_lib) {
+        auto free_ordering = reinterpret_cast<void(*)(BddVarOrdering*)>(dlsym(rust_lib, "free_var_ordering"));
+        if (ordering && free_ordering) free_ordering(ordering);
+        S.unloadRustLibrary(rust_lib);
+    }
+}
+
+
+//=================================================================================================
+// Unrolling:
+
+
+// Marks the variables the properties and the constraints depend on, through the gates and the
+// next-state functions of the latches.
+void Bmc::computeCoi()
+{
+    vec<int> gate (aig.maxVar + 1, -1), latch(aig.maxVar + 1, -1);
+    for (int i = 0; i < aig.ands   .size(); i++) gate [aig.ands   [i].lhs >> 1] = i;
+    for (int i = 0; i < aig.latches.size(); i++) latch[aig.latches[i].lit >> 1] = i;
+
+    coi.clear();
+    coi.growTo(aig.maxVar + 1, 0);
+    vec<unsigned> stack;
+    const vec<unsigned>& props = aig.properties();
+    for (int i = 0; i < props          .size(); i++) stack.push(props[i] >> 1);
+    for (int i = 0; i < aig.constraints.size(); i++) stack.push(aig.constraints[i] >> 1);
+    while (stack.size() > 0) {
+        unsigned v = stack.last(); stack.pop();
+        if (coi[v]) continue;
+        coi[v] = 1;
+        if (gate[v] >= 0) {
+            stack.push(aig.ands[gate[v]].rhs0 >> 1);
+            stack.push(aig.ands[gate[v]].rhs1 >> 1);
+        } else if (latch[v] >= 0)
+            stack.push(aig.latches[latch[v]].next >> 1);
+    }
+}
+
+
+void Bmc::addClause(Lit a, Lit b, Lit c)
+{
+    clause.clear();
+    clause.push(a);
+    if (b != lit_Undef) clause.push(b);
+    if (c != lit_Undef) clause.push(c);
+    S.addClause_(clause);
+    nbClauses++;
+}
+
+
+Lit Bmc::addFrame()
+{
+    int k = frames.size();
+    frames.push();
+    frames[k].growTo(aig.maxVar + 1, lit_Undef);
+    vec<Lit>& f = frames[k];
+    f[0] = ~constTrue;
+
+    for (int i = 0; i < aig.inputs.size(); i++)
+        if (coi[aig.inputs[i] >> 1]) f[aig.inputs[i] >> 1] = mkLit(S.newVar());
+
+    for (int i = 0; i < aig.latches.size(); i++) {
+        const AigerLatch& l = aig.latches[i];
+        if (!coi[l.lit >> 1]) continue;
+        if (k > 0)               f[l.lit >> 1] = lit(k - 1, l.next);
+        else if (l.reset == 0)   f[l.lit >> 1] = ~constTrue;
+        else if (l.reset == 1)   f[l.lit >> 1] = constTrue;
+        else                     f[l.lit >> 1] = mkLit(S.newVar());   // Uninitialized.
+    }
+
+    for (int i = 0; i < aig.ands.size(); i++) {
+        const AigerAnd& g = aig.ands[i];
+        if (!coi[g.lhs >> 1]) continue;
+        Lit x = mkLit(S.newVar()), a = lit(k, g.rhs0), b = lit(k, g.rhs1);
+        f[g.lhs >> 1] = x;
+        addClause(~x, a);
+        addClause(~x, b);
+        addClause(x, ~a, ~b);
+        nbGates++;
+        if (gateOrdering) {
+            gates.push_back(var(x) + 1);
+            gates.push_back(sign(a) ? -(var(a) + 1) : var(a) + 1);
+            gates.push_back(sign(b) ? -(var(b) + 1) : var(b) + 1);
+        }
+    }
+
+    for (int i = 0; i < aig.constraints.size(); i++)
+        addClause(lit(k, aig.constraints[i]));
+
+    const vec<unsigned>& props = aig.properties();
+    if (props.size() == 1) return lit(k, props[0]);
+    Lit t = mkLit(S.newVar());
+    clause.clear();
+    clause.push(~t);
+    for (int i = 0; i < props.size(); i++) clause.push(lit(k, props[i]));
+    S.addClause_(clause);
+    nbClauses++;
+    return t;
+}
+
+
+// Asks the BDD side for an ordering of the variables of the unrolling built from its gates.
+void Bmc::updateOrdering()
+{
+    if (!gateOrdering) return;
+    if (rust_lib == NULL && (rust_lib = S.loadRustLibrary()) == NULL) { gateOrdering = false; return; }
+    auto init_from_gates = reinterpret_cast<BddVarOrdering*(*)(const int*, size_t, int)>(dlsym(rust_lib, "init_from_gates"));
+    auto free_ordering   = reinterpret_cast<void(*)(BddVarOrdering*)>(dlsym(rust_lib, "free_var_ordering"));
+    if (!init_from_gates) {
+        if (S.verbosity > 0)
+            printf("c BDD ordering from the gates is not available\n");
+        gateOrdering = false;
+        return;
+    }
+    if (ordering && free_ordering) free_ordering(ordering);
+    ordering = init_from_gates(gates.data(), gates.size(), S.nVars());
+}
+
+
+//=================================================================================================
+// Checking:
+
+
+lbool Bmc::check()
+{
+    if (aig.properties().size() == 0) return l_False;
+
+    vec<Lit> assumps;
+    while (bound < maxBound && S.okay()) {
+        bound++;
+        Lit target = addFrame();
+        updateOrdering();
+
+        assumps.clear();
+        assumps.push(target);
+        nbSolverCalls++;
+        lbool ret = S.solveLimited(ordering, assumps);
+        if (S.verbosity > 0)
+            printf("c bound %4d: %s (%" PRIu64 " gates, %d variables, %.2f s)\n", bound,
+                   ret == l_True ? "bad state reached" : ret == l_False ? "no bad state" : "interrupted",
+                   nbGates, S.nVars(), cpuTime());
+        if (ret == l_Undef) return l_Undef;
+        if (ret == l_True) {
+            const vec<unsigned>& props = aig.properties();
+            for (badProperty = 0; badProperty < props.size(); badProperty++)
+                if (S.modelValue(lit(bound, props[badProperty])) == l_True) break;
+            return l_True;
+        }
+        // No bad state in 'bound' transitions: this holds in every later frame too.
+        addClause(~target);
+    }
+    return l_False;
+}
+
+
+void Bmc::writeWitness(FILE* out) const
+{
+    auto value = [&](int k, unsigned v) -> char {
+        Lit l = frames[k][v];
+        if (l == lit_Undef) return '0';                   // Out of the cone of influence.
+        lbool b = S.modelValue(l);
+        return b == l_True ? '1' : b == l_False ? '0' : 'x'; };
+
+    fprintf(out, "1\nb%d\n", badProperty);
+    for (int i = 0; i < aig.latches.size(); i++) {
+        const AigerLatch& l = aig.latches[i];
+        fputc(l.reset == 0 || l.reset == 1 ? '0' + l.reset : value(0, l.lit >> 1), out);
+    }
+    fputc('\n', out);
+    for (int k = 0; k <= bound; k++) {
+        for (int i = 0; i < aig.inputs.size(); i++) fputc(value(k, aig.inputs[i] >> 1), out);
+        fputc('\n', out);
+    }
+    fprintf(out, ".\n");
+}
+
+
+void Bmc::printStats() const
+{
+    printf("c bound                 : %d\n", bound);
+    printf("c gates encoded         : %" PRIu64" (%" PRIu64" clauses)\n", nbGates, nbClauses);
+    printf("c solver calls          : %" PRIu64"\n", nbSolverCalls);
+}
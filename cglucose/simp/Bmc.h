@@ -0,0 +1,81 @@
+/*
+    Bounded model checking of AIGER circuits (see core/Aiger.h).
+
+    The circuit is unrolled into a single incremental solver, one time frame per bound: the gates
+    of frame k are Tseitin encoded (three clauses per and-gate) with addClause_, the latches of
+    frame k are the next-state literals of frame k-1 (no clause needed), and only the cone of
+    influence of the properties and the invariant constraints is encoded. Bound k is checked by a
+    call under the assumption that a bad state is reached at frame k; when there is none, the
+    negation is added as a unit, so every bound reuses the clauses learnt by the previous ones.
+
+    The BDD side gets the gate structure of the unrolling, when the Rust library provides the
+    optional entry point
+
+        BddVarOrdering* init_from_gates(const int* gates, size_t len, int nb_vars)
+
+    'gates' being the and-gates as triples of DIMACS literals (output, input, input), in
+    topological order. Otherwise the search runs without a BDD variable ordering.
+
+    Variable elimination must be turned off (the constructor does it on an empty solver): the
+    frames to come refer to the variables of the previous ones.
+*/
+
+#ifndef Glucose_Bmc_h
+#define Glucose_Bmc_h
+
+#include <stdio.h>
+#include <vector>
+
+#include "core/Aiger.h"
+#include "simp/SimpSolver.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// Bmc -- looks for a bad state of a circuit within a bounded number of transitions:
+
+class Bmc {
+public:
+    Bmc(SimpSolver& s, const Aiger& aig);
+    ~Bmc();
+
+    // Checks the bounds 0, 1, ... up to 'maxBound' transitions. Returns l_True if a bad state is
+    // reachable in 'bound' transitions (see writeWitness), l_False if there is none within
+    // 'maxBound', and l_Undef if the search was interrupted at 'bound'.
+    lbool check();
+
+    // Writes the counterexample found by 'check' in the AIGER witness format.
+    void  writeWitness(FILE* out) const;
+    void  printStats  () const;
+
+    // Parameters:
+    int      maxBound;
+    bool     gateOrdering;       // Hand the gates to the BDD side for its variable ordering.
+
+    // Results and statistics:
+    int      bound;              // Last bound checked.
+    int      badProperty;        // Index of the property violated (if l_True).
+    uint64_t nbGates, nbClauses, nbSolverCalls;
+
+protected:
+    SimpSolver&      S;
+    const Aiger&     aig;
+    vec<char>        coi;        // AIGER variables in the cone of influence.
+    vec<vec<Lit> >   frames;     // frames[k][v]: literal of the AIGER variable 'v' at time 'k'.
+    Lit              constTrue;
+    vec<Lit>         clause;
+    std::vector<int> gates;      // Gates encoded so far, for 'init_from_gates'.
+    void*            rust_lib;
+    BddVarOrdering*  ordering;
+
+    Lit  lit      (int k, unsigned a) const { Lit l = frames[k][a >> 1]; return (a & 1) ? ~l : l; }
+    void computeCoi();
+    void addClause(Lit a, Lit b = lit_Undef, Lit c = lit_Undef);
+    Lit  addFrame ();            // Returns the literal of a bad state at the new frame.
+    void updateOrdering();
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,344 @@
+/*
+    AllSAT / projected model enumeration with BDD-compressed blocking.
+    See Enumerator.h
+*/
+
+#include <dlfcn.h>
+#include <iostream>
+
+#include "utils/System.h"
+#include "simp/Enumerator.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Options:
+
+
+static const char* _cat = "ENUM";
+
+static Int64Option  opt_enum_max    (_cat, "enum-max",     "Max number of cubes to enumerate (-1 means no limit)", -1, Int64Range(-1, INT64_MAX));
+static IntOption    opt_enum_compact(_cat, "enum-compact", "Number of cubes between two compactions of the blocking clauses into a BDD", 1000, IntRange(1, INT32_MAX));
+
+
+//=================================================================================================
+// Constructor/Destructor:
+
+
+Enumerator::Enumerator(SimpSolver& s) :
+    maxCubes          (opt_enum_max)
+  , compactEvery      (opt_enum_compact)
+  , nbCubes           (0)
+  , nbSolverCalls     (0)
+  , nbCompactions     (0)
+  , nbBlockingClauses (0)
+  , nbBddNodes        (0)
+  , S                 (s)
+  , nbVarsInitial     (s.nVars())
+  , activation        (var_Undef)
+  , pendingCubes      (0)
+  , rust_lib          (NULL)
+  , blocking          (NULL)
+{
+    setProjection("");
+}
+
+
+Enumerator::~Enumerator()
+{
+    if (rust_lib) {
+        auto free_blocking = reinterpret_cast<void(*)(BddBlocking*)>(dlsym(rust_lib, "free_blocking_bdd"));
+        if (blocking && free_blocking) free_blocking(blocking);
+        S.unloadRustLibrary(rust_lib);
+    }
+}
+
+
+bool Enumerator::setProjection(const char* spec)
+{
+    projection.clear();
+    projected.assign(nbVarsInitial, 0);
+
+    if (*spec == '\0') {
+        for (Var v = 0; v < nbVarsInitial; v++) projection.push_back(v), projected[v] = 1;
+        return true;
+    }
+
+    while (*spec != '\0') {
+        char* end;
+        long first = strtol(spec, &end, 10), last = first;
+        if (end == spec) return false;
+        if (*end == '-') {
+            spec = end + 1;
+            last = strtol(spec, &end, 10);
+            if (end == spec) return false;
+        }
+        if (first < 1 || last > nbVarsInitial || first > last) return false;
+        for (long v = first - 1; v < last; v++)
+            if (!projected[v]) projection.push_back(v), projected[v] = 1;
+        if (*end == ',') end++;
+        else if (*end != '\0') return false;
+        spec = end;
+    }
+    return true;
+}
+
+
+//=================================================================================================
+// Enumeration:
+
+
+/*_________________________________________________________________________________________________
+|
+|  enumerate : (bdd_var_ordering : BddVarOrdering*) (out : FILE*)  ->  [lbool]
+|
+|  Description:
+|    Find a model under the activation literal of the current generation, shrink it to a cube
+|    over the projection, write and block the cube, and start again until the solver is
+|    unsatisfiable under the activation literal (all projected models are covered).
+|________________________________________________________________________________________________@*/
+lbool Enumerator::enumerate(BddVarOrdering* bdd_var_ordering, FILE* out)
+{
+    if (!S.okay()) return l_False;
+    if (S.certifiedUNSAT) {
+        fprintf(stderr, "c Can not enumerate models with certified UNSAT\n");
+        exit(-1);
+    }
+
+    // The BDD side collects the cubes. Without it, cubes stay blocked by clauses.
+    rust_lib = S.loadRustLibrary();
+    if (rust_lib) {
+        auto create_blocking = reinterpret_cast<BddBlocking*(*)(BddVarOrdering*)>(dlsym(rust_lib, "create_blocking_bdd"));
+        if (create_blocking && dlsym(rust_lib, "add_blocking_cube") && dlsym(rust_lib, "blocking_bdd_nodes"))
+            blocking = create_blocking(bdd_var_ordering);
+    }
+    if (!blocking && S.verbosity > 0)
+        printf("c BDD blocking is not available, cubes are blocked by clauses only\n");
+
+    newGeneration();
+
+    vec<Lit> assumps, cube;
+    for (;;) {
+        if (maxCubes >= 0 && (int64_t)nbCubes >= maxCubes) return l_Undef;
+
+        assumps.clear();
+        assumps.push(mkLit(activation));
+        nbSolverCalls++;
+        // The BDD side helps the first search only: the later ones are short, and mostly about the
+        // blocking clauses, which it does not know
+        lbool ret = S.solveLimited(nbSolverCalls == 1 ? bdd_var_ordering : NULL, assumps);
+        if (ret == l_Undef) return l_Undef;
+        if (ret == l_False) return nbCubes == 0 ? l_False : l_True;
+
+        shrinkModel(cube);
+        writeCube(out, cube);
+        nbCubes++;
+        BigCount models(1);
+        nbModels += models.shiftLeft(projection.size() - cube.size());
+
+        // An empty cube means that every projected assignment is a model
+        if (cube.size() == 0 || !blockCube(cube)) return l_True;
+        if (blocking && pendingCubes >= compactEvery && !compact()) return l_True;
+    }
+}
+
+
+// Value of a literal in the last model. Tseitin variables of the BDD are not decision variables
+// and may be unassigned: they are taken as false, which satisfies their (upward) clauses.
+
+bool Enumerator::modelTrue(Lit p) const
+{
+    lbool v = S.model[var(p)];
+    if (v == l_Undef) return sign(p);
+    return (v ^ sign(p)) == l_True;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  shrinkModel : (cube : vec<Lit>&)  ->  [void]
+|
+|  Description:
+|    Compute a cube over the projection such that every extension of it satisfies all the
+|    clauses of the solver (the variables which are not projected keep their value in the model).
+|    Every clause is covered by a true literal: first for free by a non projected literal, then
+|    greedily by projected ones. Since the blocking clauses and the BDD encoding are clauses of
+|    the solver too, the cube is disjoint from all the cubes found before.
+|________________________________________________________________________________________________@*/
+void Enumerator::shrinkModel(vec<Lit>& cube)
+{
+    cube.clear();
+    inCube.resize(S.nVars(), 0);
+
+    vec<CRef> uncovered;
+    for (int i = 0; i < S.clauses.size(); i++) {
+        const Clause& c = S.ca[S.clauses[i]];
+        if (c.mark() == 1) continue;
+        bool covered = false;
+        for (int j = 0; j < c.size() && !covered; j++)
+            covered = S.value(c[j]) == l_True || (!isProjected(var(c[j])) && modelTrue(c[j]));
+        if (!covered) uncovered.push(S.clauses[i]);
+    }
+
+    for (int i = 0; i < uncovered.size(); i++) {
+        const Clause& c = S.ca[uncovered[i]];
+        Lit choice = lit_Undef;
+        for (int j = 0; j < c.size(); j++)
+            if (modelTrue(c[j])) {
+                if (inCube[var(c[j])]) { choice = lit_Undef; break; }
+                if (choice == lit_Undef) choice = c[j];
+            }
+        if (choice != lit_Undef) {
+            inCube[var(choice)] = 1;
+            cube.push(choice);
+        }
+    }
+
+    // Projected variables fixed at level 0 belong to every model
+    for (int i = 0; i < S.trail.size(); i++)
+        if (isProjected(var(S.trail[i])) && !inCube[var(S.trail[i])]) {
+            inCube[var(S.trail[i])] = 1;
+            cube.push(S.trail[i]);
+        }
+
+    for (int i = 0; i < cube.size(); i++) inCube[var(cube[i])] = 0;
+}
+
+
+// Block a cube with a clause of the current generation and send it to the BDD side.
+// Returns false if no model is left.
+
+bool Enumerator::blockCube(const vec<Lit>& cube)
+{
+    vec<Lit> clause;
+    clause.push(~mkLit(activation));
+    for (int i = 0; i < cube.size(); i++) clause.push(~cube[i]);
+
+    if (blocking) {
+        auto add_cube = reinterpret_cast<void(*)(BddBlocking*, const int*, size_t)>(dlsym(rust_lib, "add_blocking_cube"));
+        std::vector<int> lits;
+        for (int i = 0; i < cube.size(); i++)
+            lits.push_back((var(cube[i]) + 1) * (-2 * sign(cube[i]) + 1));
+        add_cube(blocking, lits.data(), lits.size());
+    }
+
+    nbBlockingClauses++;
+    pendingCubes++;
+    return S.addClause(clause);
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  compact : ()  ->  [bool]
+|
+|  Description:
+|    Retire the current generation of blocking clauses (the unit ~activation satisfies them and
+|    'simplify' removes them) and block the union of all the cubes with a Tseitin encoding of
+|    the BDD. The BDD side returns its nodes as [root, (var, hi, lo)*] where children are node
+|    indices, -1 for the FALSE terminal and -2 for the TRUE terminal. For each node 'n' over 'x',
+|    (x & t_hi -> t_n) and (~x & t_lo -> t_n) are added, then ~t_root. Any assignment in the
+|    union forces t_root. Returns false if no model is left.
+|
+|    The retired clauses, the previous encoding and the learnt clauses derived from them all
+|    contain the negation of a retired activation literal: they are removed at once, and the
+|    Tseitin variables of the previous encoding are reused by the next ones. The number of
+|    variables grows by one (the retired activation variable) per compaction.
+|________________________________________________________________________________________________@*/
+bool Enumerator::compact()
+{
+    typedef std::pair<const int*, size_t> (*RustNodes)(BddBlocking*);
+    RustNodes blocking_nodes = reinterpret_cast<RustNodes>(dlsym(rust_lib, "blocking_bdd_nodes"));
+    auto rust_data = blocking_nodes(blocking);
+    size_t length = std::get<1>(rust_data);
+    std::vector<int> buffer;
+    if (std::get<0>(rust_data) != NULL) buffer.assign(std::get<0>(rust_data), std::get<0>(rust_data) + length);
+    // The buffer is freed through the optional entry point; an older library without it leaks one
+    // buffer (three ints per node) per compaction.
+    auto free_nodes = reinterpret_cast<void(*)(const int*, size_t)>(dlsym(rust_lib, "free_blocking_nodes"));
+    if (std::get<0>(rust_data) != NULL && free_nodes) free_nodes(std::get<0>(rust_data), length);
+
+    const int* nodes = buffer.data();
+    bool valid = buffer.size() > 0 && (length - 1) % 3 == 0 && (length - 1) / 3 <= (size_t)INT32_MAX;
+    int  nbNodes = valid ? (length - 1) / 3 : 0;
+    // Every node and child index must be a node or a terminal, every variable one of the input
+    if (valid) valid = nodes[0] >= -2 && nodes[0] < nbNodes;
+    for (int i = 0; i < nbNodes && valid; i++) {
+        int v = nodes[1 + 3 * i], hi = nodes[2 + 3 * i], lo = nodes[3 + 3 * i];
+        valid = v >= 1 && v <= nbVarsInitial && hi >= -2 && hi < nbNodes && lo >= -2 && lo < nbNodes;
+    }
+    if (!valid) {
+        fprintf(stderr, "c Malformed BDD received from Rust, keeping the blocking clauses\n");
+        pendingCubes = 0;
+        return true;
+    }
+
+    nbCompactions++;
+    if (!S.addClause(~mkLit(activation))) return false;
+    S.simpDB_props = 0;                // Remove the satisfied clauses now
+    if (!S.simplify()) return false;
+    for (int i = 0; i < tseitin.size(); i++) freeVars.push(tseitin[i]);
+    tseitin.clear();
+    newGeneration();
+    pendingCubes = 0;
+
+    int root = nodes[0];
+    if (root == -2) return false;
+    if (root == -1) return true;
+
+    nbBddNodes = nbNodes;
+    for (int i = 0; i < nbNodes; i++)
+        tseitin.push(encodingVar());
+
+    vec<Lit> clause;
+    for (int i = 0; i < nbNodes; i++) {
+        Lit x = mkLit(nodes[1 + 3 * i] - 1);
+        for (int b = 0; b < 2; b++) {
+            int child = nodes[2 + 3 * i + b];
+            if (child == -1) continue;
+            clause.clear();
+            clause.push(~mkLit(activation));
+            clause.push(b == 0 ? ~x : x);
+            if (child >= 0) clause.push(~mkLit(tseitin[child]));
+            clause.push(mkLit(tseitin[i]));
+            if (!S.addClause(clause)) return false;
+        }
+    }
+    return S.addClause(~mkLit(activation), ~mkLit(tseitin[root]));
+}
+
+
+void Enumerator::newGeneration()
+{
+    activation = encodingVar();
+}
+
+
+// A variable of a retired encoding, which occurs in no clause any more, or a new one.
+
+Var Enumerator::encodingVar()
+{
+    while (freeVars.size() > 0) {
+        Var v = freeVars.last();
+        freeVars.pop();
+        if (S.value(v) == l_Undef) return v;
+    }
+    return S.newVar(true, false);
+}
+
+
+void Enumerator::writeCube(FILE* out, const vec<Lit>& cube) const
+{
+    fprintf(out, "v");
+    for (int i = 0; i < cube.size(); i++)
+        fprintf(out, " %s%d", sign(cube[i]) ? "-" : "", var(cube[i]) + 1);
+    fprintf(out, " 0\n");
+}
+
+
+void Enumerator::printStats() const
+{
+    printf("c cubes                 : %" PRIu64" (%s projected models)\n", nbCubes, nbModels.toString().c_str());
+    printf("c solver calls          : %" PRIu64"\n", nbSolverCalls);
+    printf("c blocking clauses      : %" PRIu64" (%" PRIu64" compactions, last BDD with %" PRIu64" nodes)\n", nbBlockingClauses, nbCompactions, nbBddNodes);
+}
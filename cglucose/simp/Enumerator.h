@@ -0,0 +1,81 @@
+/*
+    AllSAT / projected model enumeration.
+
+    Models are found with the solver used incrementally (solveLimited under an activation
+    literal) and each one is shrunk to a short cube over the projection variables: every clause
+    of the solver is covered by a literal true in the model, preferring literals over variables
+    which are not projected. Every extension of such a cube over the projection variables is a
+    projected model, so a cube blocks a whole region at once.
+
+    Cubes are blocked by clauses of the current generation and collected in a BDD on the Rust
+    side. Every 'compactEvery' cubes, the generation is retired and replaced by a Tseitin
+    encoding of the BDD (two clauses per node), so the number of blocking clauses stays linear
+    in the size of the BDD instead of the number of models. The clauses retired by a compaction
+    are removed from the solver and the Tseitin variables of the previous encoding are reused.
+*/
+
+#ifndef Glucose_Enumerator_h
+#define Glucose_Enumerator_h
+
+#include "simp/SimpSolver.h"
+#include "simp/ModelCounter.h"
+#include <vector>
+
+typedef struct BddBlocking BddBlocking;
+
+namespace Glucose {
+
+//=================================================================================================
+// Enumerator -- enumerates the projected models of the formula stored in a solver:
+
+class Enumerator {
+public:
+    Enumerator(SimpSolver& s);
+    ~Enumerator();
+
+    // Set the projection from a list of ranges of variables such as "1-20,35" (an empty string
+    // means all variables). Returns false on a malformed list.
+    bool setProjection(const char* spec);
+
+    // Enumerate the cubes and write them to 'out'. Returns l_True if all models were enumerated,
+    // l_Undef if a limit was reached, and l_False if the formula is unsatisfiable.
+    lbool enumerate(BddVarOrdering* bdd_var_ordering, FILE* out);
+    void  printStats() const;
+
+    // Parameters:
+    int64_t  maxCubes;           // Max number of cubes (-1 means no limit).
+    int      compactEvery;       // Number of cubes between two compactions of the blocking clauses.
+
+    // Statistics:
+    uint64_t nbCubes, nbSolverCalls, nbCompactions, nbBlockingClauses, nbBddNodes;
+    BigCount nbModels;           // Number of projected models covered by the cubes.
+
+protected:
+    SimpSolver&        S;
+    int                nbVarsInitial;  // Variables of the input formula (the others are activation / Tseitin variables).
+    std::vector<Var>   projection;
+    std::vector<char>  projected;
+    std::vector<char>  inCube;
+    Var                activation;     // Guard of the blocking clauses of the current generation.
+    int                pendingCubes;   // Cubes blocked by clauses since the last compaction.
+    vec<Var>           tseitin;        // Variables of the current encoding of the BDD, by node.
+    vec<Var>           freeVars;       // Variables of the retired encodings, reused by the next ones.
+
+    // BDD side:
+    void*              rust_lib;
+    BddBlocking*       blocking;
+
+    bool  isProjected(Var v) const { return v < nbVarsInitial && projected[v]; }
+    bool  modelTrue(Lit p) const;
+    void  shrinkModel(vec<Lit>& cube);
+    bool  blockCube(const vec<Lit>& cube);
+    bool  compact();
+    void  newGeneration();
+    Var   encodingVar();
+    void  writeCube(FILE* out, const vec<Lit>& cube) const;
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -56,10 +56,22 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "utils/System.h"
 #include "utils/ParseUtils.h"
 #include "utils/Options.h"
+#include "utils/JsonWriter.h"
+#include "utils/Hash.h"
 #include "core/Dimacs.h"
+#include "core/BinaryCnf.h"
+#include "core/Opb.h"
+#include "core/ResultCache.h"
 #include "simp/SimpSolver.h"
+#include "simp/ModelCounter.h"
+#include "simp/Enumerator.h"
+#include "simp/Backbone.h"
+#include "simp/Prefetcher.h"
+#include "simp/TimeSlicer.h"
+#include "simp/Bmc.h"
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 
 #include "CallPythonFile.h"
@@ -83,46 +95,6 @@ extern "C" {
     void free_bdd_var_ordering(BddVarOrdering* bdd_bar_ordering_ptr);
 }
 
-BddVarOrdering*  init_rust(const char* filePath) {
-    
-    // Load the Rust dynamic library
-    void* rust_lib = dlopen("/home/lkondylidou/Desktop/PhD/CDCL-support-by-BDD-methods/target/release/librust_lib.so", RTLD_LAZY); // Update the path accordingly
-
-    if (!rust_lib) {
-        std::cerr << "Failed to load the Rust library: " << dlerror() << std::endl;
-        return NULL;
-    }
-
-    // Get pointers to the Rust functions
-    auto rust_init = reinterpret_cast<BddVarOrdering*(*)(const char*)>(dlsym(rust_lib, "init"));
-    auto free_bdd_var_ordering_ptr = reinterpret_cast<void(*)(BddVarOrdering*)>(dlsym(rust_lib, "free_var_ordering"));
-
-    if (!rust_init || !free_bdd_var_ordering_ptr) {
-        std::cerr << "Failed to get function pointers from the Rust library: " << dlerror() << std::endl;
-        dlclose(rust_lib);
-        return NULL;
-    }
-
-    // Call the Rust function to create BddVarOrdering
-    BddVarOrdering* bdd_var_ordering = rust_init(filePath);
-
-    // Check if the creation was successful
-    if (!bdd_var_ordering) {
-        std::cerr << "Failed to create BddVarOrdering in Rust" << std::endl;
-        dlclose(rust_lib);
-        return NULL;
-    }
-
-    // Use the BddVarOrdering as needed
-
-    // Free the BddVarOrdering when done
-    //free_bdd_var_ordering_ptr(bdd_var_ordering);
-
-    // Unload the Rust library
-    dlclose(rust_lib);
-    return bdd_var_ordering;
-}
-
 static const char* _certified = "CORE -- CERTIFIED UNSAT";
 
 void printStats(Solver& solver)
@@ -143,16 +115,80 @@ void printStats(Solver& solver)
     printf("c propagations          : %-12" PRIu64"   (%.0f /sec)\n", solver.propagations, solver.propagations/cpu_time);
     printf("c conflict literals     : %-12" PRIu64"   (%4.2f %% deleted)\n", solver.tot_literals, (solver.max_literals - solver.tot_literals)*100 / (double)solver.max_literals);
     printf("c nb reduced Clauses    : %" PRIu64"\n",solver.nbReducedClauses);
+    if (solver.nPbs() > 0)
+        printf("c PB constraints        : %-12d   (%" PRIu64" propagations, %" PRIu64" conflicts)\n", solver.nPbs(), solver.nbPbPropagations, solver.nbPbConflicts);
+    if (solver.nbBddRuns > 0)
+        printf("c BDD runs              : %-12" PRIu64"   (%" PRIu64" literals sent, %" PRIu64" clauses received, %.2f s)\n", solver.nbBddRuns, solver.nbBddLitsSent, solver.nbBddClauses, solver.bddTime);
+    if (solver.bddStrengthen)
+        printf("c BDD strengthened      : %-12" PRIu64"   (%" PRIu64" literals removed)\n", solver.nbBddStrengthened, solver.nbBddStrengthenedLits);
+    if (solver.bddNodeBudget > 0)
+        printf("c memory budget         : %" PRIu64" BDD nodes (peak %" PRIu64", %" PRIu64" shrinks, %" PRIu64" pauses), %" PRIu64" MB of clauses (%" PRIu64" forced reductions)\n",
+               solver.bddNodeBudget, solver.bddPeakNodes, solver.nbBddShrinks, solver.nbBddPauses, solver.arenaMemBudget >> 20, solver.nbArenaReductions);
     
+    if (solver.timePhases) solver.phaseTimer.printStats();
+    if (solver.perf != NULL) solver.perf->printStats();
+    if (solver.accountMemory) solver.memAccount.printStats();
+    if (solver.histograms && solver.hist.lbd.count() > 0) printf("c distributions         :\n"), solver.hist.print();
     if (mem_used != 0) printf("Memory used           : %.2f MB\n", mem_used);
     printf("c CPU time              : %g s\n", cpu_time);
 }
 
+static const char* statusName(lbool ret)
+{
+    return ret == l_True ? "SATISFIABLE" : ret == l_False ? "UNSATISFIABLE" : "INDETERMINATE";
+}
+
+// One JSON line per instance: the result, the statistics of the solver, the memory high-water
+// mark and the value of every option.
+static void writeStatsJson(FILE* out, Solver& solver, const char* instance, const char* mode, lbool ret,
+                           double cpuStart, double realStart, const char* modelCount = NULL)
+{
+    JsonWriter json(out);
+    json.beginObject();
+    json.value("instance", instance);
+    json.value("mode", mode);
+    json.value("status", statusName(ret));
+    if (modelCount != NULL) json.value("model_count", modelCount);
+    json.value("cpu_time", cpuTime() - cpuStart);
+    json.value("wall_time", realTime() - realStart);
+    json.beginObject("memory");
+    json.value("peak_mb", memUsedPeak());
+    json.value("current_mb", memUsed());
+    json.endObject();
+    json.beginObject("stats");
+    solver.writeStats(json);
+    json.endObject();
+    if (ret == l_True && solver.showModel) {
+        json.beginArray("model");
+        for (int i = 0; i < solver.model.size(); i++)
+            if (solver.model[i] != l_Undef)
+                json.value(NULL, solver.model[i] == l_True ? i + 1 : -(i + 1));
+        json.endArray();
+    }
+    writeOptionsJson(json, "config");
+    json.endObject();
+    fflush(out);
+}
+
 static Solver* solver;
 // Terminate by notifying the solver and back out gracefully. This is mainly to have a test-case
 // for this feature of the Solver as it may take longer than an immediate call to '_exit()'.
 static void SIGINT_interrupt(int signum) { solver->interrupt(); }
 
+// The same for the instances of a batch solved in turns (see -slice).
+static TimeSlicer* slicer;
+static void SIGINT_slicer(int signum) { slicer->interrupt(); }
+
+// The clones of a backbone computation are interrupted too
+static Backbone* backboneRun;
+static void SIGINT_backbone(int signum) { backboneRun->interrupt(); }
+
+// Ask the running solvers for a statistics snapshot at their next conflict and keep going.
+static void SIGUSR1_snapshot(int signum) { Solver::requestSnapshot(); }
+
+// Ask the solver for a checkpoint at its next restart (see -checkpoint).
+static void SIGUSR2_checkpoint(int signum) { Solver::requestCheckpoint(); }
+
 // Note that '_exit()' rather than 'exit()' has to be used. The reason is that 'exit()' calls
 // destructors and may cause deadlocks if a malloc/free function happens to be running (these
 // functions are guarded by locks for multithreaded use).
@@ -189,6 +225,18 @@ void saveToListAndCallPython(Solver& S, std::string instanceName){
 
 
 
+// Variable elimination on the prefetch thread: quiet, and without opening the performance counters,
+// which are those of the thread running the search.
+static void eliminateAhead(SimpSolver& S, bool turn_off_elim) {
+    bool perf = S.perfCounters;
+    int  verb = S.verbosity;
+    S.perfCounters = false;
+    S.verbosity    = -1;
+    S.eliminate(turn_off_elim);
+    S.perfCounters = perf;
+    S.verbosity    = verb; }
+
+
 //=================================================================================================
 // Main:
 
@@ -199,7 +247,7 @@ int main(int argc, char** argv)
       printf("c\nc This is glucose 4.0 --  based on MiniSAT (Many thanks to MiniSAT team)\nc\n");
 
       
-      setUsageHelp("c USAGE: %s [options] <input-file> <result-output-file>\n\n  where input may be either in plain or gzipped DIMACS.\n");
+      setUsageHelp("c USAGE: %s [options] <input-file> <result-output-file>\n\n  where input may be plain, gzipped, xz, zstd or bzip2 compressed DIMACS.\n");
         
         
 #if defined(__linux__)
@@ -220,6 +268,27 @@ int main(int argc, char** argv)
 
          BoolOption    opt_certified      (_certified, "certified",    "Certified UNSAT using DRUP format", false);
          StringOption  opt_certified_file      (_certified, "certified-output",    "Certified UNSAT output file", "NULL");
+
+        BoolOption   opt_count ("MAIN", "count", "Count the models of the formula (#SAT) instead of solving it.", false);
+        BoolOption   opt_enum  ("ENUM", "enum", "Enumerate the (projected) models of the formula as cubes instead of solving it.", false);
+        StringOption opt_enum_proj("ENUM", "enum-proj", "Projection variables, as a list of ranges such as 1-20,35 (default: all variables).", "");
+        StringOption opt_enum_out ("ENUM", "enum-out", "If given, write the cubes to this file instead of stdout.");
+        BoolOption   opt_backbone ("BACKBONE", "backbone", "Compute the backbone of the formula (the literals true in every model) instead of solving it.", false);
+        StringOption stats_json("MAIN", "stats-json", "If given, append the result and the statistics of every instance to this file (JSON lines).");
+        StringOption warm_in ("MAIN", "warm-in", "If given, import the phases, activities and implied clauses of a previous run on a related instance from this file.");
+        StringOption warm_out("MAIN", "warm-out", "If given, export the phases, activities and short learnt clauses of the run to this file (see -warm-size and -warm-lbd).");
+        StringOption to_binary("MAIN", "to-binary", "If given, convert the input to a binary CNF file with this name (loaded without parsing by later runs) and exit.");
+        StringOption learnt_log ("MAIN", "learnt-log", "If given, log the short learnt clauses of the search to this file (see -learnt-log-lbd), to seed later runs on the same formula.");
+        StringOption learnt_seed("MAIN", "learnt-seed", "If given, import the learnt clauses logged by a previous run on the same formula (see -learnt-log) before the search.");
+        StringOption restore("MAIN", "restore", "If given, resume the search from this checkpoint (see -checkpoint) instead of parsing the instance it was written for.");
+        StringOption batch   ("MAIN", "batch", "If given, solve the instances listed in this file (one per line) one after the other.");
+        IntOption    prefetch("MAIN", "prefetch", "Number of instances of the batch loaded on a helper thread ahead of the one being solved (0 = load each one in turn).", 1, IntRange(0, 64));
+        BoolOption   prefetch_simp("MAIN", "prefetch-simp", "Also run the variable elimination of the prefetched instances on the helper thread (when the search would run it, i.e. with -no-pre).", false);
+        Int64Option  slice       ("MAIN", "slice", "If not 0, solve the instances of the batch in turns of this many conflicts on one thread, easy ones first.", 0, Int64Range(0, INT64_MAX));
+        IntOption    slice_active("MAIN", "slice-active", "Maximum number of instances in progress at once with -slice.", 64, IntRange(1, INT32_MAX));
+        IntOption    opb_bdd("MAIN", "opb-bdd", "Max BDD nodes per term of a pseudo-Boolean constraint of an OPB file encoded into clauses (larger ones are propagated natively, 0 = all).", 8, IntRange(0, 1024));
+        StringOption cache("MAIN", "cache", "If given, answer the instances already solved by an earlier run from this directory, and store the new answers there.");
+        StringOption bmc("BMC", "bmc", "If given, look for a bad state of this AIGER circuit (aag or aig) by bounded model checking (see -bmc-bound) and exit.");
          
         parseOptions(argc, argv, true);
         double      initial_time = cpuTime();
@@ -251,49 +320,259 @@ int main(int argc, char** argv)
                     printf("c WARNING! Could not set resource limit: Virtual memory.\n");
             } }
         
-        if (argc == 1)
+        // Memory budget of the solver: the smaller of -mem-lim and the limit of the cgroup. A quarter
+        // is left to the watches, the trail and the rest of the process.
+        double mem_budget = memLimit();
+        if (mem_lim != INT32_MAX && (mem_budget == 0 || mem_lim < mem_budget))
+            mem_budget = mem_lim;
+
+        // The DRUP proof derives every clause the search uses: seeded or restored ones come from another run
+        if (opt_certified && learnt_seed)
+            printf("c ERROR! -certified can not be combined with -learnt-seed (the seeded clauses are not in the proof)\n"), exit(1);
+        if (opt_certified && restore)
+            printf("c ERROR! -certified can not be combined with -restore (the restored clauses are not in the proof)\n"), exit(1);
+
+        if (argc == 1 && !batch && !bmc)
             printf("c Reading from standard input... Use '--help' for help.\n");     
+
+        if (to_binary) {
+            double convert_time = realTime();
+            if (!convert_BinaryCnf(argc >= 2 ? argv[1] : NULL, to_binary))
+                printf("c ERROR! Could not write the binary CNF file %s\n", (const char*)to_binary), exit(1);
+            printf("c Wrote %s in %.2f s\n", (const char*)to_binary, realTime() - convert_time);
+            exit(0);
+        }
         
         FILE* res = (argc >= 3) ? fopen(argv[argc-1], "wb") : NULL;
+        FILE* json_out = stats_json ? fopen(stats_json, "ab") : NULL;
+        if (stats_json && json_out == NULL)
+            printf("c ERROR! Could not open file: %s\n", (const char*)stats_json), exit(1);
  
         // Change to signal-handlers that will only notify the solver and allow it to terminate
         // voluntarily:
         signal(SIGINT, SIGINT_interrupt);
         signal(SIGXCPU,SIGINT_interrupt);
+        signal(SIGUSR1,SIGUSR1_snapshot);
+        signal(SIGUSR2,SIGUSR2_checkpoint);
+
+        if (bmc) {
+            double initial_real = realTime();
+            SimpSolver S;
+            S.verbosity = verb;
+            S.verbEveryConflicts = vv;
+            if (mem_budget > 0)
+                S.setMemoryBudget((uint64_t)(mem_budget * 1024 * 1024) / 4 * 3);
+            solver = &S;
+
+            Aiger aig;
+            parse_Aiger(bmc, aig);
+            if (S.verbosity > 0)
+                printf("c AIGER circuit: %u variables, %d inputs, %d latches, %d and-gates, %d properties, %d constraints\n",
+                       aig.maxVar, aig.inputs.size(), aig.latches.size(), aig.ands.size(), aig.properties().size(), aig.constraints.size());
+
+            Bmc checker(S, aig);
+            lbool ret = checker.check();
+            if (S.verbosity > 0) {
+                checker.printStats();
+                printStats(S);
+                printf("\n"); }
+            if (ret == l_True)
+                checker.writeWitness(stdout);
+            else {
+                // Safe if the unrolling itself became unsatisfiable, unknown beyond the bound otherwise
+                bool safe = ret == l_False && !S.okay();
+                printf("c %s\n", safe ? "no bad state is reachable" : ret == l_False ? "no bad state within the bound" : "interrupted");
+                printf("%d\nb0\n.\n", safe ? 0 : 2);
+            }
+            if (json_out) writeStatsJson(json_out, S, bmc, "bmc", ret, initial_time, initial_real);
+            exit(ret == l_True ? 10 : ret == l_False ? 20 : 0);
+        }
 
 /*
 Put the names of the cnf file in the filePaths array, can be done better of course, 
 but for testing purpose it is made that simple. Future improvement will be done.
 */        
 
-        const char* filePaths[] = {
+        std::vector<const char*> filePaths = {
             "sgen.cnf",      
             "/home/lkondylidou/Desktop/PhD/CDCL-support-by-BDD-methods/benchmarks/tests/sgp_6-6-10.sat05-2670.reshuffled-07.cnf"   
            // "fuhs-aprove-16.cnf"
         };
 
-        int size = sizeof(filePaths) / sizeof(filePaths[0]);
-        
-        if(argc == 2){
-            //Loop trough the files and create a new solver for each file
-            for (int i = 0; i < size; ++i) {
-            SimpSolver S = SimpSolver();
+        // Or list them in a file, one per line:
+        std::vector<std::string> batchFiles;
+        if (batch) {
+            std::ifstream list((const char*)batch);
+            if (!list)
+                printf("c ERROR! Could not open file: %s\n", (const char*)batch), exit(1);
+            std::string line;
+            while (std::getline(list, line)) {
+                size_t b = line.find_first_not_of(" \t\r"), e = line.find_last_not_of(" \t\r");
+                if (b != std::string::npos && line[b] != '#') batchFiles.push_back(line.substr(b, e - b + 1));
+            }
+            filePaths.clear();
+            for (size_t k = 0; k < batchFiles.size(); k++) filePaths.push_back(batchFiles[k].c_str());
+        }
 
-            double initial_time = cpuTime();
+        int size = filePaths.size();
+        // Counting and enumeration walk the clauses only, and the node variables of the BDD encoding
+        // of the pseudo-Boolean constraints would be free in their models.
+        for (int i = 0; i < size; i++) {
+            if (opt_certified && isOpbFile(filePaths[i]))
+                printf("c ERROR! -certified needs a CNF input, not the OPB file %s\n", filePaths[i]), exit(1);
+            if ((opt_count || opt_enum) && isOpbFile(filePaths[i]))
+                printf("c ERROR! -count and -enum need a CNF input, not the OPB file %s\n", filePaths[i]), exit(1);
+        }
+
+        // Answers of the instances solved by an earlier run: the key is the hash of the input, computed
+        // by the loader as it parses (the same text read as OPB or as DIMACS is not the same formula),
+        // and looked up before the search. Only the plain search is cached.
+        bool caching = cache && (argc == 2 || batch) && !opt_count && !opt_enum && !opt_backbone && !dimacs
+                    && !restore && !opt_certified && !warm_out && !learnt_log;
+        std::unique_ptr<ResultCache> results(caching ? new ResultCache(cache) : NULL);
+        std::vector<uint64_t>        input_hash(size, 0);
+        std::vector<char>            hashed(size, 0);
+        ResultCache::Entry           cached;
+        vec<Lit>                     no_assumps;
+
+        auto lookupAnswer = [&](int i) {
+            return caching && hashed[i] && results->lookup(input_hash[i], no_assumps, cached); };
+        // Reports an instance answered from the cache (see 'lookupAnswer') as if it had been solved.
+        auto answerFromCache = [&](int i, Solver& S, double initial_time, double initial_real) {
+            cached.model.copyTo(S.model);
+            if (verb > 0) printf("c %s: answer from the cache\n", filePaths[i]);
+            printf(cached.status == l_True ? "s SATISFIABLE\n" : "s UNSATISFIABLE\n");
+            if (json_out) writeStatsJson(json_out, S, filePaths[i], "cache", cached.status, initial_time, initial_real);
+            saveToListAndCallPython(S, filePaths[i]);
+            instances.emplace_back(i+1,cpuTime());
+        };
+        auto storeAnswer = [&](int i, Solver& S, lbool ret) {
+            if (caching && hashed[i] && ret != l_Undef)
+                results->store(input_hash[i], no_assumps, ret, S.model, S.conflict);
+        };
+        auto printCacheStats = [&]() {
+            if (caching && verb > 0)
+                printf("c cache                 : %" PRIu64" hits, %" PRIu64" misses, %" PRIu64" answers stored\n",
+                       results->nbHits, results->nbMisses, results->nbStores);
+        };
+
+        // Elimination ahead of the search only when the search would run it: the other modes turn it
+        // off, and the learnt clause logs identify the formula before any simplification.
+        bool simp_ahead = prefetch_simp && !pre && !opt_count && !opt_enum && !opt_backbone && !learnt_log && !learnt_seed;
+
+        // The DRUP proof of an instance is opened by its loader and written from its parse on: loading
+        // ahead would truncate the proof of the instance being solved, or write into its output.
+        int lookahead = opt_certified ? 0 : (int)prefetch;
+
+        // Builds the solver of an instance, up to the parse. With -prefetch this runs on a helper
+        // thread while the previous instance is solved, so it prints nothing of its own: its errors
+        // are thrown (see ParseErrorTrap), and reported when the instance is taken.
+        Prefetcher prefetcher(argc == 2 || batch ? size : 0, lookahead, [&](int i, Prefetcher::Instance& inst) {
+            std::unique_ptr<SimpSolver> s(new SimpSolver());
+            SimpSolver& S = *s;
 
             S.parsing = 1;
             S.verbosity = verb;
             S.verbEveryConflicts = vv;
-	        S.showModel = mod;
+            S.showModel = mod;
+            if (mem_budget > 0)
+                S.setMemoryBudget((uint64_t)(mem_budget * 1024 * 1024) / 4 * 3);
             S.certifiedUNSAT = opt_certified;
             if(S.certifiedUNSAT) {
-            if(!strcmp(opt_certified_file,"NULL")) {
-            S.certifiedOutput =  fopen("/dev/stdout", "wb");
-            } else {
-                S.certifiedOutput =  fopen(opt_certified_file, "wb");	    
+                if(!strcmp(opt_certified_file,"NULL")) {
+                    S.certifiedOutput =  fopen("/dev/stdout", "wb");
+                } else {
+                    S.certifiedOutput =  fopen(opt_certified_file, "wb");
+                }
+                fprintf(S.certifiedOutput,"o proof DRUP\n");
             }
-            fprintf(S.certifiedOutput,"o proof DRUP\n");
-        }
+            S.parsing = 0;
+
+            if (pre/* && !S.isIncremental()*/)
+                eliminateAhead(S, true);
+
+            S.checkpointName = filePaths[i];
+            if (restore && S.loadCheckpoint(restore))
+                inst.declaredVars = S.nVars();
+            else {
+                if (S.nVars() > 0)
+                    throw ParseError{1, stdout, std::string("c ERROR! Could not restore the checkpoint ") + (const char*)restore + "\n"};
+                bool opb = isOpbFile(filePaths[i]);
+                if (!caching)
+                    inst.declaredVars = opb ? parse_OPB(filePaths[i], S, opb_bdd) : parse_CNF(filePaths[i], S);
+                else {
+                    // The key of the cache is hashed from the bytes the parse reads, so the input is
+                    // read once. Binary CNF files are mapped rather than read: they are hashed apart.
+                    uint64_t h = 0;
+                    if (isBinaryCnf(filePaths[i])) {
+                        hashed[i] = ResultCache::hashInput(filePaths[i], h);
+                        inst.declaredVars = parse_CNF(filePaths[i], S);
+                    } else {
+                        std::unique_ptr<InputStream> input(InputStream::open(filePaths[i]));
+                        if (input == NULL) parseFail(1);
+                        HashedInputStream hashed_input(*input);
+                        inst.declaredVars = opb ? parse_OPB(hashed_input, S, opb_bdd) : parse_DIMACS(hashed_input, S);
+                        h = hashed_input.hash.digest();
+                        hashed[i] = 1;
+                    }
+                    StreamHash key(opb);
+                    key.update64(h);
+                    input_hash[i] = key.digest();
+                }
+            }
+            if (simp_ahead)
+                eliminateAhead(S, false);
+            inst.solver = s.release();
+        });
+        
+        if (slice && (opt_count || opt_enum || opt_backbone || dimacs || opt_certified || warm_in || warm_out || learnt_log || learnt_seed))
+            printf("c ERROR! -slice only solves the instances: it can not be combined with -count, -enum, -backbone, -dimacs, -certified, -warm-* or -learnt-*\n"), exit(1);
+
+        if ((argc == 2 || batch) && slice){
+            // Many small instances: their searches take turns on this thread
+            TimeSlicer ts(slice, slice_active);
+            std::vector<double> start_time(size), start_real(size);
+            slicer = &ts;
+            signal(SIGINT, SIGINT_slicer);
+            signal(SIGXCPU,SIGINT_slicer);
+            bool done = ts.run(size, [&](int i, TimeSlicer::Job& job) {
+                start_time[i] = cpuTime();
+                start_real[i] = realTime();
+                Prefetcher::Instance inst = prefetcher.take(i);
+                if (lookupAnswer(i)) {
+                    answerFromCache(i, *inst.solver, start_time[i], start_real[i]);
+                    delete inst.solver;
+                    return;
+                }
+                job.solver    = inst.solver;
+                job.ordering  = Solver::initBddOrdering(filePaths[i]);
+                job.solver->verbosity = 0;     // The turns of the instances would interleave their output
+            }, [&](int i, TimeSlicer::Job& job, lbool ret) {
+                SimpSolver& S = *job.solver;
+                printf("c %s: %" PRIu64 " conflicts in %" PRIu64 " turns, %.2f s\n", filePaths[i], S.conflicts, job.slices, job.searchTime);
+                printf(ret == l_True ? "s SATISFIABLE\n" : ret == l_False ? "s UNSATISFIABLE\n" : "s INDETERMINATE\n");
+                if (json_out) writeStatsJson(json_out, S, filePaths[i], "solve", ret, start_time[i], start_real[i]);
+                storeAnswer(i, S, ret);
+                saveToListAndCallPython(S, filePaths[i]);
+                instances.emplace_back(i+1,cpuTime());
+            });
+            if (verb > 0)
+                printf("c %" PRIu64 " turns of %" PRId64 " conflicts, at most %d instances in progress%s\n",
+                       ts.nbSlices, (int64_t)slice, ts.maxResident, done ? "" : " (interrupted)");
+            printCacheStats();
+            vectorToPython(lists);
+            solvedInstances(instances);
+        } else if(argc == 2 || batch){
+            //Loop trough the files and create a new solver for each file
+            for (int i = 0; i < size; ++i) {
+            double initial_time = cpuTime();
+            double initial_real = realTime();
+
+            Prefetcher::Instance inst = prefetcher.take(i);
+            std::unique_ptr<SimpSolver> owner(inst.solver);
+            SimpSolver& S = *inst.solver;
+            solver = &S;
+            if (lookupAnswer(i)) { answerFromCache(i, S, initial_time, initial_real); continue; }
 
         if (S.verbosity > 0){
             printf("c ========================================[ Problem Statistics ]===========================================\n");
@@ -304,13 +583,11 @@ but for testing purpose it is made that simple. Future improvement will be done.
         
         double parsed_time = cpuTime();
         if (S.verbosity > 0){
-            printf("c |  Parse time:           %12.2f s                                                                 |\n", parsed_time - initial_time);
+            printf("c |  Parse time:           %12.2f s                                                                 |\n", inst.loadTime);
             printf("c |                                                                                                       |\n"); }
-         S.parsing = 0;
 
          if(pre/* && !S.isIncremental()*/) {
 	  printf("c | Preprocesing is fully done\n");
-	  S.eliminate(true);
         double simplified_time = cpuTime();
         if (S.verbosity > 0){
             printf("c |  Simplification time:  %12.2f s                                                                 |\n", simplified_time - parsed_time);
@@ -326,10 +603,14 @@ but for testing purpose it is made that simple. Future improvement will be done.
                 printStats(S);
                 printf("\n"); }
             printf("s UNSATISFIABLE\n");        
+            if (json_out) writeStatsJson(json_out, S, filePaths[i], "solve", l_False, initial_time, initial_real);
+            storeAnswer(i, S, l_False);
             exit(20);
         }
 
         if (dimacs){
+            if (S.nPbs() > 0)
+                printf("c ERROR! -dimacs can not write the native pseudo-Boolean constraints (see -opb-bdd)\n"), exit(1);
             if (S.verbosity > 0)
                 printf("c =======================================[ Writing DIMACS ]===============================================\n");
             S.toDimacs((const char*)dimacs);
@@ -337,30 +618,125 @@ but for testing purpose it is made that simple. Future improvement will be done.
                 printStats(S);
             exit(0);
         }
-            gzFile in = gzopen(filePaths[i],"rb"); 
-            parse_DIMACS(in, S);
-            gzclose(in);
+            int declared_vars = inst.declaredVars;
+            // Identifies the formula in the learnt clause logs: before any simplification
+            uint64_t problem_hash = learnt_log || learnt_seed ? S.problemHash() : 0;
+
+            // The BDD side reads the input itself, as DIMACS text (NULL for the other formats)
+            BddVarOrdering* bdd_var_ordering = Solver::initBddOrdering(filePaths[i]);
+
+            if (opt_count) {
+                // Variable elimination does not preserve the number of models
+                S.use_elim = false;
+                S.eliminate(true);
+                ModelCounter counter(S);
+                BigCount nb_models;
+                bool exact = counter.count(bdd_var_ordering, nb_models, declared_vars);
+                if (S.verbosity > 0) {
+                    counter.printStats();
+                    printStats(S);
+                    printf("\n"); }
+                if (exact)
+                    printf("s mc %s\n", nb_models.toString().c_str());
+                else
+                    printf("s UNKNOWN\n");
+                if (json_out) writeStatsJson(json_out, S, filePaths[i], "count", exact ? (nb_models.isZero() ? l_False : l_True) : l_Undef,
+                                             initial_time, initial_real, exact ? nb_models.toString().c_str() : NULL);
+                continue;
+            }
+
+            if (opt_enum) {
+                // Variable elimination does not preserve the projected models
+                S.use_elim = false;
+                S.eliminate(true);
+                // Declared variables which do not occur in the clauses are free in the models
+                while (S.nVars() < declared_vars) S.newVar();
+                Enumerator enumerator(S);
+                if (!enumerator.setProjection(opt_enum_proj)) {
+                    fprintf(stderr, "ERROR! Malformed projection: %s\n", (const char*)opt_enum_proj);
+                    exit(1);
+                }
+                FILE* cubes = opt_enum_out ? fopen(opt_enum_out, "wb") : stdout;
+                if (cubes == NULL)
+                    fprintf(stderr, "ERROR! Could not open file: %s\n", (const char*)opt_enum_out), exit(1);
+                lbool ret = enumerator.enumerate(bdd_var_ordering, cubes);
+                if (cubes != stdout) fclose(cubes);
+                if (S.verbosity > 0) {
+                    enumerator.printStats();
+                    printStats(S);
+                    printf("\n"); }
+                printf(ret == l_True ? "s SATISFIABLE\n" : ret == l_False ? "s UNSATISFIABLE\n" : "s INDETERMINATE\n");
+                if (json_out) writeStatsJson(json_out, S, filePaths[i], "enum", ret, initial_time, initial_real);
+                continue;
+            }
 
-            BddVarOrdering* bdd_var_ordering = init_rust(filePaths[i]);
+            if (opt_backbone) {
+                // Eliminated variables can not be tested under assumptions
+                S.use_elim = false;
+                S.eliminate(true);
+                Backbone backbone(S);
+                vec<Lit> lits;
+                backboneRun = &backbone;
+                signal(SIGINT, SIGINT_backbone);
+                signal(SIGXCPU,SIGINT_backbone);
+                lbool ret = backbone.compute(bdd_var_ordering, lits, declared_vars);
+                signal(SIGINT, SIGINT_interrupt);
+                signal(SIGXCPU,SIGINT_interrupt);
+                if (S.verbosity > 0) {
+                    backbone.printStats();
+                    printStats(S);
+                    printf("\n"); }
+                if (ret == l_True) {
+                    printf("v");
+                    for (int k = 0; k < lits.size(); k++)
+                        printf(" %s%d", sign(lits[k]) ? "-" : "", var(lits[k]) + 1);
+                    printf(" 0\n");
+                }
+                printf(ret == l_True ? "s SATISFIABLE\n" : ret == l_False ? "s UNSATISFIABLE\n" : "s INDETERMINATE\n");
+                if (json_out) writeStatsJson(json_out, S, filePaths[i], "backbone", ret, initial_time, initial_real);
+                continue;
+            }
+
+            if (warm_in) {
+                // Imported learnt clauses must not mention eliminated variables
+                S.eliminate(true);
+                S.loadWarmStart(warm_in);
+            }
+            if (learnt_seed) {
+                S.eliminate(true);
+                S.loadLearntLog(learnt_seed, problem_hash);
+            }
+            if (learnt_log) S.openLearntLog(learnt_log, problem_hash);
 
             vec<Lit> dummy;
             lbool ret = S.solveLimited(bdd_var_ordering, dummy);
+            if (warm_out) S.writeWarmStart(warm_out);
+            if (learnt_log && !S.closeLearntLog())
+                fprintf(stderr, "c WARNING! The learnt clause log %s is incomplete\n", (const char*)learnt_log);
 
              if (S.verbosity > 0){
             printStats(S);
             printf("\n"); }
             printf(ret == l_True ? "s SATISFIABLE\n" : ret == l_False ? "s UNSATISFIABLE\n" : "s INDETERMINATE\n");
+            if (json_out) writeStatsJson(json_out, S, filePaths[i], "solve", ret, initial_time, initial_real);
+            storeAnswer(i, S, ret);
             std::string instanceName = filePaths[i]; 
             saveToListAndCallPython(S, instanceName);
             instances.emplace_back(i+1,cpuTime());
             }
+            printCacheStats();
             vectorToPython(lists);
             solvedInstances(instances);
         }
+        if (json_out) fclose(json_out);
 
     } catch (OutOfMemoryException&){
 	        printf("c =========================================================================================================\n");
         printf("INDETERMINATE\n");
         exit(0);
+    } catch (ParseError& e){
+        // Of an instance loaded ahead (see Prefetcher), after the answers of the previous ones
+        e.report();
+        exit(e.status);
     }
 }
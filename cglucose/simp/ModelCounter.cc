@@ -0,0 +1,359 @@
+/*
+    Model counting (#SAT): BDD bucket counting with a component caching fallback.
+    See ModelCounter.h
+*/
+
+#include <algorithm>
+#include <dlfcn.h>
+#include <iostream>
+
+#include "utils/System.h"
+#include "simp/ModelCounter.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Options:
+
+
+static const char* _cat = "COUNT";
+
+static Int64Option opt_count_bdd_nodes(_cat, "count-bdd-nodes", "Max number of BDD nodes used to count the models before falling back to the component counter (DPLL with a component cache, no clause learning)", 1 << 24, Int64Range(1, INT64_MAX));
+static Int64Option opt_count_budget   (_cat, "count-budget",    "Max number of decisions of the component counter (-1 means no limit)", -1, Int64Range(-1, INT64_MAX));
+static IntOption   opt_count_cache    (_cat, "count-cache",     "Max number of components kept in the cache of the component counter", 1000000, IntRange(1, INT32_MAX));
+
+
+//=================================================================================================
+// Constructor:
+
+
+ModelCounter::ModelCounter(SimpSolver& s) :
+    bddNodeBudget  (opt_count_bdd_nodes)
+  , decisionBudget (opt_count_budget)
+  , cacheLimit     (opt_count_cache)
+  , countedByBDD   (false)
+  , decisions      (0)
+  , components     (0)
+  , cacheHits      (0)
+  , cacheFlushes   (0)
+  , S              (s)
+  , aborted        (false)
+{}
+
+
+/*_________________________________________________________________________________________________
+|
+|  count : (bdd_var_ordering : BddVarOrdering*) (out : BigCount&) (nbVars : int)  ->  [bool]
+|
+|  Description:
+|    Count the models of the clauses of the solver over 'nbVars' variables. Must be called at
+|    level 0, after count-preserving simplifications only. Variables fixed at level 0 count once,
+|    variables which do not occur in any remaining clause count twice.
+|________________________________________________________________________________________________@*/
+bool ModelCounter::count(BddVarOrdering* bdd_var_ordering, BigCount& out, int nbVars)
+{
+    out = BigCount();
+    if (nbVars < S.nVars()) nbVars = S.nVars();
+    if (!S.okay()) return true;
+
+    assert(S.decisionLevel() == 0);
+    if (S.eliminated_vars > 0) {
+        fprintf(stderr, "c Can not count models after variable elimination (use -no-elim)\n");
+        return false;
+    }
+
+    // Collect the clauses which are not satisfied at level 0:
+    assigns.assign(S.nVars(), l_Undef);
+    occ.assign(2 * S.nVars(), std::vector<int>());
+    cls.clear();
+    for (int i = 0; i < S.clauses.size(); i++) {
+        const Clause& c = S.ca[S.clauses[i]];
+        if (c.mark() == 1 || S.satisfied(c)) continue;
+        std::vector<Lit> lits;
+        for (int j = 0; j < c.size(); j++)
+            if (S.value(c[j]) != l_False) {
+                lits.push_back(c[j]);
+                occ[toInt(c[j])].push_back(cls.size());
+            }
+        cls.push_back(lits);
+    }
+    inComponent.assign(cls.size(), 0);
+    varSeen.assign(S.nVars(), 0);
+
+    if (bdd_var_ordering != NULL && countWithBDD(bdd_var_ordering, nbVars, out)) {
+        countedByBDD = true;
+        return true;
+    }
+
+    // Fallback: variables fixed at level 0 count once, unused ones twice
+    int freeVars = nbVars - S.nVars();
+    for (Var v = 0; v < S.nVars(); v++)
+        if (S.value(v) == l_Undef && occ[toInt(mkLit(v))].empty() && occ[toInt(~mkLit(v))].empty())
+            freeVars++;
+
+    std::vector<int> all(cls.size());
+    for (size_t i = 0; i < cls.size(); i++) all[i] = i;
+    std::vector<std::vector<int> > comps;
+    splitComponents(all, comps);
+
+    BigCount result(1);
+    for (size_t i = 0; i < comps.size() && !result.isZero() && !aborted; i++)
+        result = result * countComponent(comps[i]);
+    if (aborted) return false;
+
+    out = result.shiftLeft(freeVars);
+    return true;
+}
+
+
+// Ask the BDD side to count the models. The clauses (and the units found at level 0) are sent in
+// the 0-terminated format used for the learnt clauses. The Rust side returns the number of models
+// as a decimal string, or NULL if the node budget was exceeded.
+
+bool ModelCounter::countWithBDD(BddVarOrdering* bdd_var_ordering, int nbVars, BigCount& out)
+{
+    void* rust_lib = S.loadRustLibrary();
+    if (!rust_lib) return false;
+
+    typedef const char* (*RustCount)(BddVarOrdering*, const int*, size_t, int, size_t);
+    RustCount rust_count = reinterpret_cast<RustCount>(dlsym(rust_lib, "count_models"));
+    auto free_count = reinterpret_cast<void(*)(const char*)>(dlsym(rust_lib, "free_model_count"));
+    if (!rust_count) {
+        std::cerr << "Error loading Rust function: " << dlerror() << std::endl;
+        S.unloadRustLibrary(rust_lib);
+        return false;
+    }
+
+    std::vector<int> clauses;
+    for (int i = 0; i < S.trail.size(); i++) {
+        clauses.push_back((var(S.trail[i]) + 1) * (-2 * sign(S.trail[i]) + 1));
+        clauses.push_back(0);
+    }
+    for (size_t i = 0; i < cls.size(); i++) {
+        for (size_t j = 0; j < cls[i].size(); j++)
+            clauses.push_back((var(cls[i][j]) + 1) * (-2 * sign(cls[i][j]) + 1));
+        clauses.push_back(0);
+    }
+
+    const char* nb = rust_count(bdd_var_ordering, clauses.data(), clauses.size(), nbVars, (size_t)bddNodeBudget);
+    bool done = nb != NULL && BigCount::fromString(nb, out);
+    if (nb != NULL && free_count) free_count(nb);
+    if (!done && S.verbosity > 0)
+        printf("c BDD node budget exceeded, counting with components\n");
+
+    S.unloadRustLibrary(rust_lib);
+    return done;
+}
+
+
+//=================================================================================================
+// Component counter:
+
+
+bool ModelCounter::clauseSatisfied(int c) const
+{
+    for (size_t i = 0; i < cls[c].size(); i++)
+        if (value(cls[c][i]) == l_True) return true;
+    return false;
+}
+
+
+// Assign 'p' and propagate it over the clauses. Returns false on a conflict.
+bool ModelCounter::propagate(Lit p)
+{
+    size_t qhead = trail.size();
+    assigns[var(p)] = lbool(!sign(p));
+    trail.push_back(p);
+
+    while (qhead < trail.size()) {
+        const std::vector<int>& cs = occ[toInt(~trail[qhead++])];
+        for (size_t i = 0; i < cs.size(); i++) {
+            const std::vector<Lit>& c = cls[cs[i]];
+            Lit unit = lit_Undef;
+            int nbUndef = 0;
+            bool sat = false;
+            for (size_t j = 0; j < c.size() && !sat; j++)
+                if (value(c[j]) == l_True) sat = true;
+                else if (value(c[j]) == l_Undef) nbUndef++, unit = c[j];
+            if (sat) continue;
+            if (nbUndef == 0) return false;
+            if (nbUndef == 1) {
+                assigns[var(unit)] = lbool(!sign(unit));
+                trail.push_back(unit);
+            }
+        }
+    }
+    return true;
+}
+
+
+void ModelCounter::undo(size_t trailSize)
+{
+    while (trail.size() > trailSize) {
+        assigns[var(trail.back())] = l_Undef;
+        trail.pop_back();
+    }
+}
+
+
+// Split a set of clauses into connected components (two clauses are connected if they share an
+// unassigned variable).
+void ModelCounter::splitComponents(const std::vector<int>& clauses, std::vector<std::vector<int> >& comps)
+{
+    comps.clear();
+    std::vector<int> stack, touched;
+    for (size_t i = 0; i < clauses.size(); i++) inComponent[clauses[i]] = 1;
+
+    for (size_t i = 0; i < clauses.size(); i++) {
+        if (inComponent[clauses[i]] != 1) continue;
+        comps.push_back(std::vector<int>());
+        std::vector<int>& comp = comps.back();
+        inComponent[clauses[i]] = 2;
+        stack.push_back(clauses[i]);
+        while (!stack.empty()) {
+            int c = stack.back(); stack.pop_back();
+            comp.push_back(c);
+            for (size_t j = 0; j < cls[c].size(); j++) {
+                Var v = var(cls[c][j]);
+                if (assigns[v] != l_Undef || varSeen[v]) continue;
+                varSeen[v] = 1;
+                touched.push_back(v);
+                for (int s = 0; s < 2; s++) {
+                    const std::vector<int>& cs = occ[toInt(mkLit(v, s))];
+                    for (size_t k = 0; k < cs.size(); k++)
+                        if (inComponent[cs[k]] == 1)
+                            inComponent[cs[k]] = 2, stack.push_back(cs[k]);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < clauses.size(); i++) inComponent[clauses[i]] = 0;
+    for (size_t i = 0; i < touched.size(); i++) varSeen[touched[i]] = 0;
+}
+
+
+// Identify the component of 'f.clauses' (its key: the clauses and their unassigned variables, the
+// other literals of the clauses are false) and choose its branching variable. Returns false, with
+// its count in 'out', if the component needs no branching: found in the cache, or out of budget.
+bool ModelCounter::openComponent(Frame& f, BigCount& out)
+{
+    f.key = f.clauses;
+    std::sort(f.key.begin(), f.key.end());
+    f.key.push_back(-1);
+    f.firstVar = f.key.size();
+    for (size_t i = 0; i < f.clauses.size(); i++)
+        for (size_t j = 0; j < cls[f.clauses[i]].size(); j++) {
+            Var v = var(cls[f.clauses[i]][j]);
+            if (assigns[v] == l_Undef && !varSeen[v]) varSeen[v] = 1, f.key.push_back(v);
+        }
+    for (size_t i = f.firstVar; i < f.key.size(); i++) varSeen[f.key[i]] = 0;
+    std::sort(f.key.begin() + f.firstVar, f.key.end());
+
+    auto it = cache.find(f.key);
+    if (it != cache.end()) { cacheHits++; out = it->second; return false; }
+
+    if (decisionBudget >= 0 && (int64_t)decisions >= decisionBudget) { aborted = true; out = BigCount(); return false; }
+    components++;
+
+    // Branch on the variable with the most occurrences in the component
+    f.best = var_Undef;
+    size_t bestOcc = 0;
+    for (size_t i = f.firstVar; i < f.key.size(); i++) {
+        size_t n = occ[toInt(mkLit(f.key[i]))].size() + occ[toInt(~mkLit(f.key[i]))].size();
+        if (f.best == var_Undef || n > bestOcc) f.best = f.key[i], bestOcc = n;
+    }
+    f.side = 0;
+    f.total = BigCount();
+    return true;
+}
+
+
+// Assign the branching variable of 'f' to the side 'f.side' and split the clauses left into
+// components. A conflict leaves no component and a zero count for the branch.
+void ModelCounter::startBranch(Frame& f)
+{
+    decisions++;
+    f.trailSize = trail.size();
+    f.comps.clear();
+    f.next = 0;
+    f.branch = BigCount();
+    f.freeVars = 0;
+    if (!propagate(mkLit(f.best, f.side))) return;
+
+    std::vector<int> rest;
+    for (size_t i = 0; i < f.clauses.size(); i++)
+        if (!clauseSatisfied(f.clauses[i])) rest.push_back(f.clauses[i]);
+
+    // Variables of the component which are neither assigned nor in a remaining clause are free
+    for (size_t i = f.firstVar; i < f.key.size(); i++)
+        if (assigns[f.key[i]] == l_Undef) f.freeVars++;
+    splitComponents(rest, f.comps);
+    for (size_t i = 0; i < rest.size(); i++)
+        for (size_t k = 0; k < cls[rest[i]].size(); k++) {
+            Var v = var(cls[rest[i]][k]);
+            if (assigns[v] == l_Undef && !varSeen[v]) varSeen[v] = 1, f.freeVars--;
+        }
+    for (size_t i = f.firstVar; i < f.key.size(); i++) varSeen[f.key[i]] = 0;
+    f.branch = BigCount(1);
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  countComponent : (clauses : const std::vector<int>&)  ->  [BigCount]
+|
+|  Description:
+|    Count the assignments of the unassigned variables of a connected set of non satisfied
+|    clauses which satisfy them: DPLL branching, with the components of each branch counted
+|    apart and cached (there is no clause learning). The components in progress are kept on an
+|    explicit stack, since the depth of the search grows with the number of variables.
+|________________________________________________________________________________________________@*/
+BigCount ModelCounter::countComponent(const std::vector<int>& clauses)
+{
+    std::vector<Frame> stack(1);
+    BigCount count;
+    stack.back().clauses = clauses;
+    if (!openComponent(stack.back(), count)) return count;
+    startBranch(stack.back());
+
+    for (;;) {
+        Frame& f = stack.back();
+        if (!aborted && f.next < f.comps.size() && !f.branch.isZero()) {
+            // Count the next component of the branch, in place or on a frame of its own
+            Frame child;
+            child.clauses.swap(f.comps[f.next++]);
+            if (!openComponent(child, count))
+                f.branch = f.branch * count;
+            else {
+                stack.push_back(std::move(child));
+                startBranch(stack.back());
+            }
+            continue;
+        }
+
+        if (!f.branch.isZero()) f.total += f.branch.shiftLeft(f.freeVars);
+        undo(f.trailSize);
+        if (!aborted && ++f.side < 2) { startBranch(f); continue; }
+
+        // The component is counted
+        count = aborted ? BigCount() : f.total;
+        if (!aborted) {
+            if ((int)cache.size() >= cacheLimit) { cache.clear(); cacheFlushes++; }
+            cache[f.key] = count;
+        }
+        stack.pop_back();
+        if (stack.empty()) return count;
+        stack.back().branch = stack.back().branch * count;
+    }
+}
+
+
+void ModelCounter::printStats() const
+{
+    printf("c counted by            : %s\n", countedByBDD ? "BDD buckets" : "component caching");
+    if (!countedByBDD) {
+        printf("c count decisions       : %" PRIu64"\n", decisions);
+        printf("c count components      : %" PRIu64" (%" PRIu64" cache hits, %" PRIu64" cache flushes)\n", components, cacheHits, cacheFlushes);
+    }
+}
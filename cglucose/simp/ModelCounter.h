@@ -0,0 +1,189 @@
+/*
+    Model counting (#SAT) on top of the simplified formula of a SimpSolver.
+
+    The formula is first handed to the BDD side which counts the models bucket by bucket under
+    a node budget. If the budget is exceeded (or the Rust library is not available), the count
+    falls back to a DPLL-style counter with connected components and a component cache. It has no
+    clause learning: it is much slower than the BDD side on structured formulas, and meant for
+    the small or loosely connected ones the BDD side can not take.
+
+    Only count-preserving simplifications may be applied before counting: variable elimination
+    must be turned off (see 'use_elim'), unit propagation and removal of satisfied clauses are fine.
+*/
+
+#ifndef Glucose_ModelCounter_h
+#define Glucose_ModelCounter_h
+
+#include "simp/SimpSolver.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace Glucose {
+
+//=================================================================================================
+// BigCount -- an arbitrary precision unsigned integer (numbers of models easily exceed 2^64):
+
+class BigCount {
+    std::vector<uint32_t> limbs; // Little endian, no leading zero limb.
+
+    void trim() { while (!limbs.empty() && limbs.back() == 0) limbs.pop_back(); }
+
+public:
+    BigCount(uint64_t v = 0) { while (v) { limbs.push_back((uint32_t)v); v >>= 32; } }
+
+    bool isZero() const { return limbs.empty(); }
+
+    BigCount& operator += (const BigCount& o) {
+        uint64_t carry = 0;
+        if (limbs.size() < o.limbs.size()) limbs.resize(o.limbs.size(), 0);
+        for (size_t i = 0; i < limbs.size(); i++) {
+            uint64_t s = (uint64_t)limbs[i] + (i < o.limbs.size() ? o.limbs[i] : 0) + carry;
+            limbs[i] = (uint32_t)s;
+            carry = s >> 32;
+        }
+        if (carry) limbs.push_back((uint32_t)carry);
+        return *this;
+    }
+
+    BigCount operator * (const BigCount& o) const {
+        BigCount r;
+        if (isZero() || o.isZero()) return r;
+        r.limbs.assign(limbs.size() + o.limbs.size(), 0);
+        for (size_t i = 0; i < limbs.size(); i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < o.limbs.size(); j++) {
+                uint64_t t = (uint64_t)limbs[i] * o.limbs[j] + r.limbs[i + j] + carry;
+                r.limbs[i + j] = (uint32_t)t;
+                carry = t >> 32;
+            }
+            r.limbs[i + o.limbs.size()] += (uint32_t)carry;
+        }
+        r.trim();
+        return r;
+    }
+
+    // Multiply by 2^k
+    BigCount& shiftLeft(int k) {
+        if (isZero() || k == 0) return *this;
+        int words = k / 32, bits = k % 32;
+        if (bits) {
+            uint32_t carry = 0;
+            for (size_t i = 0; i < limbs.size(); i++) {
+                uint32_t v = limbs[i];
+                limbs[i] = (v << bits) | carry;
+                carry = v >> (32 - bits);
+            }
+            if (carry) limbs.push_back(carry);
+        }
+        limbs.insert(limbs.begin(), words, 0);
+        return *this;
+    }
+
+    std::string toString() const {
+        if (isZero()) return "0";
+        std::vector<uint32_t> n(limbs);
+        std::string s;
+        while (!n.empty()) {
+            uint64_t rem = 0;
+            for (size_t i = n.size(); i-- > 0;) {
+                uint64_t cur = (rem << 32) | n[i];
+                n[i] = (uint32_t)(cur / 1000000000);
+                rem = cur % 1000000000;
+            }
+            while (!n.empty() && n.back() == 0) n.pop_back();
+            for (int d = 0; d < 9 && (!n.empty() || rem > 0); d++, rem /= 10)
+                s.push_back('0' + rem % 10);
+        }
+        return std::string(s.rbegin(), s.rend());
+    }
+
+    // Parse a decimal number, returns false on a malformed string.
+    static bool fromString(const char* str, BigCount& out) {
+        out = BigCount();
+        if (*str == '\0') return false;
+        for (; *str; str++) {
+            if (*str < '0' || *str > '9') return false;
+            uint64_t carry = *str - '0';
+            for (size_t i = 0; i < out.limbs.size(); i++) {
+                uint64_t t = (uint64_t)out.limbs[i] * 10 + carry;
+                out.limbs[i] = (uint32_t)t;
+                carry = t >> 32;
+            }
+            if (carry) out.limbs.push_back((uint32_t)carry);
+        }
+        return true;
+    }
+};
+
+//=================================================================================================
+// ModelCounter -- counts the models of the formula stored in a solver:
+
+class ModelCounter {
+public:
+    ModelCounter(SimpSolver& s);
+
+    // Count the models over the first 'nbVars' variables (-1 means all variables of the solver).
+    // Returns false if no exact count could be computed within the budgets.
+    bool count(BddVarOrdering* bdd_var_ordering, BigCount& out, int nbVars = -1);
+    void printStats() const;
+
+    // Parameters:
+    int64_t  bddNodeBudget;      // Max number of nodes the BDD side may use before falling back.
+    int64_t  decisionBudget;     // Max number of decisions of the fallback counter (-1 means no limit).
+    int      cacheLimit;         // Max number of components in the cache before it is flushed.
+
+    // Statistics:
+    bool     countedByBDD;
+    uint64_t decisions, components, cacheHits, cacheFlushes;
+
+protected:
+    struct KeyHash {
+        size_t operator()(const std::vector<int>& k) const {
+            uint64_t h = 14695981039346656037ULL;
+            for (size_t i = 0; i < k.size(); i++) h = (h ^ (uint32_t)k[i]) * 1099511628211ULL;
+            return (size_t)h;
+        }
+    };
+
+    // A component being counted by 'countComponent':
+    struct Frame {
+        std::vector<int>               clauses;
+        std::vector<int>               key;       // Of the cache: the sorted clauses, -1, the sorted unassigned variables.
+        size_t                         firstVar;  // Index of the first variable in 'key'.
+        Var                            best;      // Branching variable.
+        int                            side;      // Branch in progress (its sign).
+        size_t                         trailSize; // Before the branch.
+        int                            freeVars;  // Unassigned variables of the component in no clause of the branch.
+        std::vector<std::vector<int> > comps;     // Components of the branch...
+        size_t                         next;      // ... the next one to count...
+        BigCount                       branch;    // ... and the product of the counts of the ones before.
+        BigCount                       total;     // Of the branches done.
+    };
+
+    SimpSolver&                       S;
+    std::vector<std::vector<Lit> >    cls;      // Clauses not satisfied at level 0, without false literals.
+    std::vector<std::vector<int> >    occ;      // 'occ[lit]' is the list of clauses containing 'lit'.
+    std::vector<lbool>                assigns;
+    std::vector<Lit>                  trail;
+    std::vector<char>                 inComponent;
+    std::vector<char>                 varSeen;
+    std::unordered_map<std::vector<int>, BigCount, KeyHash> cache;
+    bool                              aborted;
+
+    lbool value(Lit p) const { return assigns[var(p)] ^ sign(p); }
+    bool  clauseSatisfied(int c) const;
+
+    bool  countWithBDD(BddVarOrdering* bdd_var_ordering, int nbVars, BigCount& out);
+    bool  propagate(Lit p);
+    void  undo(size_t trailSize);
+    void  splitComponents(const std::vector<int>& clauses, std::vector<std::vector<int> >& comps);
+    bool  openComponent(Frame& f, BigCount& out);
+    void  startBranch(Frame& f);
+    BigCount countComponent(const std::vector<int>& clauses);
+};
+
+//=================================================================================================
+}
+
+#endif
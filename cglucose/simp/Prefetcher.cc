@@ -0,0 +1,99 @@
+/*
+    Loading of the instances of a batch ahead of the search.
+    See Prefetcher.h
+*/
+
+#include <new>
+
+#include "utils/System.h"
+#include "utils/ParseUtils.h"
+#include "simp/Prefetcher.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Prefetcher:
+
+
+Prefetcher::Prefetcher(int nb_instances, int la, Loader loader) :
+    nbInstances(nb_instances)
+  , lookahead  (la)
+  , load       (loader)
+  , taken      (0)
+  , stopping   (false)
+{
+    ready.growTo(nbInstances);
+    // The helper only pays off with a core of its own: on a single core it slows the search down.
+    if (std::thread::hardware_concurrency() <= 1) lookahead = 0;
+    if (lookahead > 0 && nbInstances > 0)
+        helper = std::thread(&Prefetcher::loadLoop, this);
+}
+
+
+Prefetcher::~Prefetcher()
+{
+    {
+        std::lock_guard<std::mutex> l(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (helper.joinable()) helper.join();
+    for (int i = taken; i < nbInstances; i++)
+        delete ready[i].solver;
+}
+
+
+void Prefetcher::loadLoop()
+{
+    for (int i = 0; i < nbInstances; i++) {
+        {
+            std::unique_lock<std::mutex> l(lock);
+            wake.wait(l, [this, i]{ return stopping || i < taken + lookahead; });
+            if (stopping) return;
+        }
+        Instance inst;
+        loadOne(i, inst);
+        {
+            std::lock_guard<std::mutex> l(lock);
+            ready[i] = inst;
+        }
+        wake.notify_all();
+    }
+}
+
+
+Prefetcher::Instance Prefetcher::take(int i)
+{
+    assert(i == taken && i < nbInstances);
+    Instance inst;
+    if (lookahead == 0) {
+        loadOne(i, inst);
+        taken++;
+    } else {
+        {
+            std::unique_lock<std::mutex> l(lock);
+            wake.wait(l, [this, i]{ return ready[i].loaded(); });
+            inst = ready[i];
+            taken++;
+        }
+        wake.notify_all();
+    }
+    if (inst.error) std::rethrow_exception(inst.error);
+    return inst;
+}
+
+
+void Prefetcher::loadOne(int i, Instance& inst)
+{
+    double start = realTime();
+    try {
+        ParseErrorTrap trap;
+        load(i, inst);
+    } catch (std::bad_alloc&) {
+        inst.error = std::make_exception_ptr(OutOfMemoryException());
+    } catch (...) {
+        inst.error = std::current_exception();
+    }
+    if (inst.error) inst.solver = NULL;    // Deleted by the loader, which owns it until it returns
+    inst.loadTime = realTime() - start;
+}
@@ -0,0 +1,73 @@
+/*
+    Loading of the instances of a batch ahead of the search.
+
+    A helper thread builds the solvers of the next instances (construction, configuration, parsing
+    and whatever the loader does) while the current one is solved, so that the load time of an
+    instance is hidden behind the search of the previous one. The lookahead bounds the number of
+    instances loaded but not taken yet, hence the memory they hold.
+
+    With a lookahead of 0, or on a single core machine, there is no thread: 'take' loads the
+    instance itself.
+
+    The loader runs with the parse errors trapped (see ParseErrorTrap): an error while loading an
+    instance, parse error or out of memory, is kept with it and thrown again by 'take', on the
+    thread which solves the instances, after the answers of the previous ones.
+*/
+
+#ifndef Glucose_Prefetcher_h
+#define Glucose_Prefetcher_h
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "simp/SimpSolver.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// Prefetcher -- loads the instances 0 .. n-1 in order:
+
+class Prefetcher {
+public:
+    struct Instance {
+        SimpSolver* solver;        // Owned by the caller of 'take'.
+        int         declaredVars;  // As returned by the parser.
+        double      loadTime;      // Wall clock seconds spent loading, on whichever thread.
+        std::exception_ptr error;  // Thrown by the loader ('solver' is then NULL).
+        Instance() : solver(NULL), declaredVars(0), loadTime(0) {}
+        bool loaded() const { return solver != NULL || error; }
+    };
+
+    // Builds the solver of instance 'i' and sets 'declaredVars'. May run on the helper thread, so it
+    // must not touch the current solver nor print in the middle of its output.
+    typedef std::function<void (int i, Instance& inst)> Loader;
+
+    Prefetcher(int nb_instances, int lookahead, Loader loader);
+    ~Prefetcher();                 // Stops the helper and deletes the solvers not taken.
+
+    // Returns instance 'i', waiting for it if needed. Instances are taken in order, once each. Throws
+    // the error of its loader, if any (an 'std::bad_alloc' as an 'OutOfMemoryException').
+    Instance take(int i);
+
+protected:
+    int                     nbInstances;
+    int                     lookahead;
+    Loader                  load;
+    vec<Instance>           ready;      // Indexed by instance; 'solver' is set once loaded.
+    int                     taken;      // Instances handed out so far.
+    bool                    stopping;
+    std::mutex              lock;
+    std::condition_variable wake;
+    std::thread             helper;
+
+    void loadLoop();
+    void loadOne (int i, Instance& inst);   // Runs the loader, keeping its error in 'inst'.
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -90,6 +90,7 @@ SimpSolver::SimpSolver() :
   , elim_heap          (ElimLt(n_occ))
   , bwdsub_assigns     (0)
   , n_touched          (0)
+  , bulk_load          (false)
 {
     vec<Lit> dummy(1,lit_Undef);
     ca.extra_clause_field = true; // NOTE: must happen before allocating the dummy clause below.
@@ -121,6 +122,7 @@ SimpSolver::SimpSolver(const SimpSolver &s) : Solver(s)
   , elim_heap          (ElimLt(n_occ))
   , bwdsub_assigns     (s.bwdsub_assigns)
   , n_touched          (s.n_touched)
+  , bulk_load          (s.bulk_load)
 {
     // TODO: Copy dummy... what is it???
     vec<Lit> dummy(1,lit_Undef);
@@ -159,7 +161,7 @@ Var SimpSolver::newVar(bool sign, bool dvar) {
         n_occ     .push(0);
         occurs    .init(v);
         touched   .push(0);
-        elim_heap .insert(v);
+        if (!bulk_load) elim_heap.insert(v);
     }
     return v; }
 
@@ -205,6 +207,36 @@ lbool SimpSolver::solve_(BddVarOrdering* bdd_var_ordering, bool do_simp, bool tu
 
 
 
+// During a bulk load the elimination heap is built once at the end instead of being updated for
+// every literal of every clause.
+void SimpSolver::beginBulkLoad(int nb_vars, uint64_t nb_clauses, uint64_t nb_lits)
+{
+    Solver::beginBulkLoad(nb_vars, nb_clauses, nb_lits);
+    frozen    .capacity(nb_vars);
+    eliminated.capacity(nb_vars);
+    if (use_simplification){
+        n_occ  .capacity(2 * nb_vars);
+        touched.capacity(nb_vars);
+        if (nb_vars > 0) occurs.init(nb_vars - 1);
+        bulk_load = true;
+    }
+}
+
+
+void SimpSolver::endBulkLoad()
+{
+    if (!bulk_load) return;
+    bulk_load = false;
+    vec<Var> vs;
+    for (Var v = 0; v < nVars(); v++)
+        if (!elim_heap.inHeap(v))
+            vs.push(v);
+    for (int i = 0; i < elim_heap.size(); i++)
+        vs.push(elim_heap[i]);
+    elim_heap.build(vs);
+}
+
+
 bool SimpSolver::addClause_(vec<Lit>& ps)
 {
 #ifndef NDEBUG
@@ -241,7 +273,7 @@ bool SimpSolver::addClause_(vec<Lit>& ps)
             n_occ[toInt(c[i])]++;
             touched[var(c[i])] = 1;
             n_touched++;
-            if (elim_heap.inHeap(var(c[i])))
+            if (!bulk_load && elim_heap.inHeap(var(c[i])))
                 elim_heap.increase(var(c[i]));
         }
     }
@@ -249,6 +281,17 @@ bool SimpSolver::addClause_(vec<Lit>& ps)
     return true;
 }
 
+
+// The variables of a pseudo-Boolean constraint are frozen: elimination only knows the clauses.
+bool SimpSolver::addPb_(vec<Lit>& lits, vec<int64_t>& weights, int64_t bound)
+{
+    for (int i = 0; i < lits.size(); i++) {
+        assert(!isEliminated(var(lits[i])));
+        setFrozen(var(lits[i]), true);
+    }
+    return Solver::addPb_(lits, weights, bound);
+}
+
 //gk
 bool SimpSolver::addClauseLink    (Lit p)          { add_tmp.clear(); add_tmp.push(p); return addClause_(add_tmp); }
 bool SimpSolver::addClauseLink    (Lit p, Lit q)          { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp); }
@@ -410,26 +453,6 @@ void SimpSolver::gatherTouchedClauses()
 }
 
 
-bool SimpSolver::implied(const vec<Lit>& c)
-{
-    assert(decisionLevel() == 0);
-
-    trail_lim.push(trail.size());
-    for (int i = 0; i < c.size(); i++)
-        if (value(c[i]) == l_True){
-            cancelUntil(0);
-            return false;
-        }else if (value(c[i]) != l_False){
-            assert(value(c[i]) == l_Undef);
-            uncheckedEnqueue(~c[i]);
-        }
-
-    bool result = propagate() != CRef_Undef;
-    cancelUntil(0);
-    return result;
-}
-
-
 // Backward subsumption + backward subsumption resolution
 bool SimpSolver::backwardSubsumptionCheck(bool verbose)
 {
@@ -692,6 +715,9 @@ void SimpSolver::extendModel()
 
 bool SimpSolver::eliminate(bool turn_off_elim)
 {
+    endBulkLoad();
+    openPerfCounters();
+    PhaseScope phase(*this, phaseSimplify);
     if (!simplify()) {
         ok = false;
         return false;
@@ -754,6 +780,7 @@ bool SimpSolver::eliminate(bool turn_off_elim)
         assert(subsumption_queue.size() == 0);
     }
  cleanup:
+    updateMemoryAccount(); // Occurrence lists are at their largest here
 
     // If no more simplification is needed, free all simplification-related data structures:
     if (turn_off_elim){
@@ -787,6 +814,40 @@ bool SimpSolver::eliminate(bool turn_off_elim)
 }
 
 
+void SimpSolver::collectMemory(MemoryAccount& acc) const
+{
+    Solver::collectMemory(acc);
+    acc.add("occurs",      occurs.bytes() + n_occ.bytes() + elim_heap.bytes() + subsumption_queue.bytes() + touched.bytes());
+    acc.add("elimclauses", elimclauses.bytes());
+}
+
+
+// Frozen and eliminated variables, and the clauses needed to extend the models to the eliminated ones.
+void SimpSolver::writeCheckpointExtra(CheckpointWriter& out) const
+{
+    out.put32(nVars());
+    for (Var v = 0; v < nVars(); v++) out.put32(frozen[v] | (eliminated[v] << 1));
+    out.put32(elimclauses.size());
+    for (int i = 0; i < elimclauses.size(); i++) out.put32(elimclauses[i]);
+}
+
+
+bool SimpSolver::readCheckpointExtra(CheckpointReader& in)
+{
+    if ((int)in.get32() != nVars()) return false;
+    for (Var v = 0; v < nVars(); v++) {
+        uint32_t flags = in.get32();
+        frozen[v]     = flags & 1;
+        eliminated[v] = (flags >> 1) & 1;
+    }
+    int n = in.get32();
+    if (!in.ok() || n < 0) return false;
+    elimclauses.clear();
+    for (int i = 0; i < n && in.ok(); i++) elimclauses.push(in.get32());
+    return in.ok();
+}
+
+
 void SimpSolver::cleanUpClauses()
 {
     occurs.cleanAll();
@@ -827,6 +888,7 @@ void SimpSolver::relocAll(ClauseAllocator& to)
 
 void SimpSolver::garbageCollect()
 {
+    PhaseScope phase(*this, phaseGarbage);
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted()); 
@@ -835,6 +897,7 @@ void SimpSolver::garbageCollect()
     to.extra_clause_field = ca.extra_clause_field; // NOTE: this is important to keep (or lose) the extra fields.
     relocAll(to);
     Solver::relocAll(to);
+    updateMemoryAccount(&to);
     if (verbosity >= 2)
         printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n", 
                ca.size()*ClauseAllocator::Unit_Size, to.size()*ClauseAllocator::Unit_Size);
@@ -88,6 +88,10 @@ class SimpSolver : public Solver {
     bool    addClause (Lit p, Lit q);        // Add a binary clause to the solver.
     bool    addClause (Lit p, Lit q, Lit r); // Add a ternary clause to the solver.
     virtual bool    addClause_(      vec<Lit>& ps);
+    virtual bool    addPb_    (vec<Lit>& lits, vec<int64_t>& weights, int64_t bound);
+    virtual void    beginBulkLoad(int nb_vars, uint64_t nb_clauses, uint64_t nb_lits);
+    virtual void    endBulkLoad  ();
+    virtual bool    canImport    (Var v) const { return !isEliminated(v); }
     bool    substitute(Var v, Lit x);  // Replace all occurences of v with x (may cause a contradiction).
 
     //gk
@@ -195,6 +199,7 @@ class SimpSolver : public Solver {
     vec<char>           eliminated;
     int                 bwdsub_assigns;
     int                 n_touched;
+    bool                bulk_load;          // Between beginBulkLoad() and endBulkLoad(): 'elim_heap' is not maintained.
 
     // Temporaries:
     //
@@ -203,6 +208,9 @@ class SimpSolver : public Solver {
     // Main internal methods:
     //
     virtual lbool         solve_                   (BddVarOrdering* bdd_var_ordering, bool do_simp = true, bool turn_off_simp = false);
+    virtual void          collectMemory            (MemoryAccount& acc) const;
+    virtual void          writeCheckpointExtra     (CheckpointWriter& out) const;
+    virtual bool          readCheckpointExtra      (CheckpointReader& in);
     bool          asymm                    (Var v, CRef cr);
     bool          asymmVar                 (Var v);
     void          updateElimHeap           (Var v);
@@ -216,7 +224,6 @@ class SimpSolver : public Solver {
     void removeClause(CRef cr, bool inPurgatory = false);
     bool          strengthenClause         (CRef cr, Lit l);
     void          cleanUpClauses           ();
-    bool          implied                  (const vec<Lit>& c);
     virtual void          relocAll                 (ClauseAllocator& to);
 };
 
@@ -0,0 +1,92 @@
+/*
+    Cooperative time-slicing of many instances on one thread.
+    See TimeSlicer.h
+*/
+
+#include <deque>
+
+#include "utils/System.h"
+#include "simp/TimeSlicer.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// TimeSlicer:
+
+
+TimeSlicer::TimeSlicer(int64_t q, int max_active) :
+    nbSlices   (0)
+  , maxResident(0)
+  , quantum    (q)
+  , maxActive  (max_active)
+  , current    (NULL)
+  , stopping   (false)
+{}
+
+
+void TimeSlicer::interrupt()
+{
+    stopping = true;
+    SimpSolver* s = current;
+    if (s != NULL) s->interrupt();
+}
+
+
+bool TimeSlicer::run(int nb_instances, Loader load, Reporter report)
+{
+    std::deque<std::pair<int, Job> > queue;
+    vec<Lit>                         no_assumps;
+    int                              next        = 0;
+    bool                             interrupted = stopping;
+
+    while (!interrupted && (next < nb_instances || !queue.empty())) {
+        while (next < nb_instances && (int)queue.size() < maxActive) {
+            queue.push_back(std::make_pair(next, Job()));
+            load(next, queue.back().second);
+            if (queue.back().second.solver == NULL) queue.pop_back();
+            next++;
+        }
+        if ((int)queue.size() > maxResident) maxResident = queue.size();
+        if (queue.empty()) continue;
+
+        std::pair<int, Job> turn = queue.front();
+        queue.pop_front();
+        Job&        job = turn.second;
+        SimpSolver& S   = *job.solver;
+
+        // The first turn runs the simplification once and for all, the next ones only search.
+        uint64_t end   = S.conflicts + quantum;
+        double   start = cpuTime();
+        S.setConfBudget(quantum);
+        current = &S;
+        lbool ret      = l_Undef;
+        bool  given_up = false;
+        try {
+            if (!stopping) ret = S.solveLimited(job.ordering, no_assumps, job.slices == 0, true);
+        } catch (OutOfMemoryException&) {
+            given_up = true;
+        }
+        current = NULL;
+        job.searchTime += cpuTime() - start;
+        job.slices++;
+        nbSlices++;
+
+        // Stopped before the end of its quantum without an answer: either the batch is interrupted,
+        // or this instance ran out of memory, and is reported as undecided while the others go on.
+        interrupted = stopping;
+        given_up    = given_up || (ret == l_Undef && S.conflicts < end);
+
+        if (ret == l_Undef && !interrupted && !given_up)
+            queue.push_back(turn);
+        else {
+            report(turn.first, job, ret);
+            delete job.solver;
+        }
+    }
+
+    for (; !queue.empty(); queue.pop_front()) {
+        report(queue.front().first, queue.front().second, l_Undef);
+        delete queue.front().second.solver;
+    }
+    return !interrupted;
+}
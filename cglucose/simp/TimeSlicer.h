@@ -0,0 +1,64 @@
+/*
+    Cooperative time-slicing of many instances on one thread.
+
+    The solvers of the instances take turns: each turn is a call to solveLimited with a budget of
+    'quantum' conflicts (see Solver::setConfBudget), after which the search stops at its next
+    restart and the solver goes back to the end of the queue with its learnt clauses, phases and
+    activities, to resume at its next turn. Easy instances are thus done after a few turns whatever
+    their position in the batch, and no instance starves the others.
+
+    At most 'maxActive' solvers are alive at once: the next instance is loaded when one is done and
+    freed, so the memory of finished instances is reused by the following ones instead of growing
+    with the size of the batch.
+*/
+
+#ifndef Glucose_TimeSlicer_h
+#define Glucose_TimeSlicer_h
+
+#include <functional>
+
+#include "simp/SimpSolver.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// TimeSlicer -- interleaves the search of the instances 0 .. n-1:
+
+class TimeSlicer {
+public:
+    struct Job {
+        SimpSolver*     solver;      // Deleted by the slicer once reported.
+        BddVarOrdering* ordering;
+        uint64_t        slices;      // Turns taken so far.
+        double          searchTime;  // CPU seconds spent in its turns.
+        Job() : solver(NULL), ordering(NULL), slices(0), searchTime(0) {}
+    };
+
+    typedef std::function<void (int i, Job& job)>               Loader;    // Sets 'solver' and 'ordering', or leaves 'solver' NULL for an instance it answered itself.
+    typedef std::function<void (int i, Job& job, lbool status)> Reporter;  // Called once per instance, when it is done.
+
+    TimeSlicer(int64_t quantum, int max_active);
+
+    // Solves the instances until all are done or the batch is interrupted (see 'interrupt'), in which
+    // case the ones in progress are reported as l_Undef and the ones not loaded yet are not reported.
+    // Returns false if interrupted. An instance which stops without an answer on its own (out of
+    // memory) is reported as l_Undef, and the others go on.
+    bool run(int nb_instances, Loader load, Reporter report);
+
+    void interrupt();                // Interrupts the solver of the current turn (async signal safe).
+
+    // Statistics:
+    uint64_t nbSlices;
+    int      maxResident;            // Highest number of solvers alive at once.
+
+protected:
+    int64_t              quantum;
+    int                  maxActive;
+    SimpSolver* volatile current;
+    volatile bool        stopping;
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*
+    64 bits hashing of byte streams and of sets of values.
+
+    StreamHash digests bytes fed in chunks of any size (the digest does not depend on how the
+    stream was cut) a word at a time. It is meant to identify contents (formulas, logs), not to
+    resist an adversary.
+*/
+
+#ifndef Glucose_Hash_h
+#define Glucose_Hash_h
+
+#include <string.h>
+
+#include "mtl/IntTypes.h"
+
+namespace Glucose {
+
+// Finalizer of splitmix64: every bit of the input affects every bit of the output.
+static inline uint64_t hashMix(uint64_t x) {
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x; }
+
+//=================================================================================================
+// StreamHash -- hash of a sequence of bytes:
+
+class StreamHash {
+    uint64_t      h;
+    uint64_t      length;
+    unsigned char tail[8];   // Bytes of an incomplete word, 'length % 8' of them.
+
+    void word(uint64_t w) { h = (h ^ hashMix(w)) * 0x9e3779b97f4a7c15ULL; h = (h << 29) | (h >> 35); }
+
+public:
+    explicit StreamHash(uint64_t seed = 0) : h(hashMix(seed + 0x2545f4914f6cdd1dULL)), length(0) {}
+
+    void update(const void* data, size_t n) {
+        const unsigned char* p = (const unsigned char*)data;
+        int t = length % 8;
+        length += n;
+        if (t > 0) {
+            while (t < 8 && n > 0) tail[t++] = *p++, n--;
+            if (t < 8) return;
+            uint64_t w; memcpy(&w, tail, 8); word(w); }
+        for (; n >= 8; p += 8, n -= 8) {
+            uint64_t w; memcpy(&w, p, 8); word(w); }
+        memcpy(tail, p, n); }
+
+    void update64(uint64_t v) { update(&v, sizeof(v)); }
+
+    uint64_t digest() const {
+        uint64_t r = h;
+        int t = length % 8;
+        if (t > 0) {
+            uint64_t w = 0; memcpy(&w, tail, t);
+            r = (r ^ hashMix(w)) * 0x9e3779b97f4a7c15ULL; }
+        return hashMix(r ^ length); }
+
+    uint64_t bytes() const { return length; }
+};
+
+//=================================================================================================
+// SetHash -- hash of a multiset of 64 bits values, whatever the order they are added in:
+
+class SetHash {
+    uint64_t sum, count;
+public:
+    SetHash() : sum(0), count(0) {}
+    void     add   (uint64_t v)  { sum += hashMix(v + 0x632be59bd9b4e019ULL); count++; }
+    uint64_t digest() const      { return hashMix(sum ^ hashMix(count)); }
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,392 @@
+/*
+    Decoders behind InputStream::open() (see InputStream.h).
+*/
+
+#include <string.h>
+#include <errno.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <zlib.h>
+#ifdef GLUCOSE_HAVE_LZMA
+#include <lzma.h>
+#endif
+#ifdef GLUCOSE_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef GLUCOSE_HAVE_BZIP2
+#include <bzlib.h>
+#endif
+
+#include "utils/InputStream.h"
+
+using namespace Glucose;
+
+namespace {
+
+//=================================================================================================
+// RawFile -- the compressed bytes, read in chunks the decoders consume in place:
+
+struct RawFile {
+    enum { chunk = 1 << 17 };
+
+    FILE*         f;
+    unsigned char buf[chunk];
+    int           pos, size;
+    bool          error;
+
+    // 'prefix' holds the bytes already read from 'file' to detect its format.
+    RawFile(FILE* file, const unsigned char* prefix, int n) : f(file), pos(0), size(n), error(false) {
+        memcpy(buf, prefix, n); }
+    ~RawFile() { if (f != stdin) fclose(f); }
+
+    // Makes sure some bytes are available, returns false at the end of the file.
+    bool fill() {
+        if (pos < size) return true;
+        pos = 0;
+        size = (int)fread(buf, 1, chunk, f);
+        if (size == 0 && ferror(f)) error = true;
+        return size > 0; }
+
+    int available() const { return size - pos; }
+};
+
+//=================================================================================================
+// Plain text:
+
+class PlainStream : public InputStream {
+    RawFile raw;
+public:
+    PlainStream(FILE* f, const unsigned char* m, int n) : raw(f, m, n) {}
+    Format format() const { return Plain; }
+
+    int read(unsigned char* out, int n) {
+        if (raw.available() > 0) {
+            int k = raw.available() < n ? raw.available() : n;
+            memcpy(out, raw.buf + raw.pos, k);
+            raw.pos += k;
+            return k; }
+        int k = (int)fread(out, 1, n, raw.f);
+        return (k == 0 && ferror(raw.f)) ? -1 : k; }
+};
+
+//=================================================================================================
+// Gzip (several concatenated members are read as one stream, like gzread does):
+
+class GzipStream : public InputStream {
+    RawFile  raw;
+    z_stream z;
+    bool     ended;
+public:
+    GzipStream(FILE* f, const unsigned char* m, int n) : raw(f, m, n), ended(false) {
+        memset(&z, 0, sizeof(z));
+        if (inflateInit2(&z, 15 + 16) != Z_OK) ended = true; }
+    ~GzipStream() { inflateEnd(&z); }
+    Format format() const { return Gzip; }
+
+    int read(unsigned char* out, int n) {
+        z.next_out  = out;
+        z.avail_out = n;
+        while (z.avail_out > 0 && !ended) {
+            if (!raw.fill()) {
+                if (raw.error || z.total_in > 0) return -1;   // Truncated member.
+                ended = true;
+                break; }
+            z.next_in  = raw.buf + raw.pos;
+            z.avail_in = raw.available();
+            int ret = inflate(&z, Z_NO_FLUSH);
+            raw.pos = raw.size - z.avail_in;
+            if (ret == Z_STREAM_END) {
+                // Another member may follow.
+                if (!raw.fill()) ended = true;
+                else inflateReset(&z);
+            } else if (ret != Z_OK && ret != Z_BUF_ERROR)
+                return -1;
+        }
+        return n - z.avail_out; }
+};
+
+//=================================================================================================
+// Xz:
+
+#ifdef GLUCOSE_HAVE_LZMA
+class XzStream : public InputStream {
+    RawFile     raw;
+    lzma_stream z;
+    bool        ended;
+public:
+    XzStream(FILE* f, const unsigned char* m, int n) : raw(f, m, n), ended(false) {
+        lzma_stream init = LZMA_STREAM_INIT;
+        z = init;
+        if (lzma_stream_decoder(&z, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) ended = true; }
+    ~XzStream() { lzma_end(&z); }
+    Format format() const { return Xz; }
+
+    int read(unsigned char* out, int n) {
+        z.next_out  = out;
+        z.avail_out = n;
+        while (z.avail_out > 0 && !ended) {
+            lzma_action action = raw.fill() ? LZMA_RUN : LZMA_FINISH;
+            if (raw.error) return -1;
+            z.next_in  = raw.buf + raw.pos;
+            z.avail_in = raw.available();
+            lzma_ret ret = lzma_code(&z, action);
+            raw.pos = raw.size - (int)z.avail_in;
+            if (ret == LZMA_STREAM_END) ended = true;
+            else if (ret != LZMA_OK) return -1;
+        }
+        return n - (int)z.avail_out; }
+};
+#endif
+
+//=================================================================================================
+// Zstd:
+
+#ifdef GLUCOSE_HAVE_ZSTD
+class ZstdStream : public InputStream {
+    RawFile       raw;
+    ZSTD_DStream* z;
+    bool          ended;
+    bool          inFrame;
+public:
+    ZstdStream(FILE* f, const unsigned char* m, int n) : raw(f, m, n), z(ZSTD_createDStream()), ended(false), inFrame(false) {
+        if (z == NULL || ZSTD_isError(ZSTD_initDStream(z))) ended = true; }
+    ~ZstdStream() { if (z != NULL) ZSTD_freeDStream(z); }
+    Format format() const { return Zstd; }
+
+    int read(unsigned char* out, int n) {
+        ZSTD_outBuffer o = { out, (size_t)n, 0 };
+        while (o.pos < o.size && !ended) {
+            if (!raw.fill()) {
+                if (raw.error || inFrame) return -1;          // Truncated frame.
+                ended = true;
+                break; }
+            ZSTD_inBuffer i = { raw.buf + raw.pos, (size_t)raw.available(), 0 };
+            size_t ret = ZSTD_decompressStream(z, &o, &i);
+            raw.pos += (int)i.pos;
+            if (ZSTD_isError(ret)) return -1;
+            inFrame = ret != 0;
+        }
+        return (int)o.pos; }
+};
+#endif
+
+//=================================================================================================
+// Bzip2 (concatenated streams, as written by pbzip2, are read as one):
+
+#ifdef GLUCOSE_HAVE_BZIP2
+class Bzip2Stream : public InputStream {
+    RawFile   raw;
+    bz_stream z;
+    bool      ended;
+public:
+    Bzip2Stream(FILE* f, const unsigned char* m, int n) : raw(f, m, n), ended(false) {
+        memset(&z, 0, sizeof(z));
+        if (BZ2_bzDecompressInit(&z, 0, 0) != BZ_OK) ended = true; }
+    ~Bzip2Stream() { BZ2_bzDecompressEnd(&z); }
+    Format format() const { return Bzip2; }
+
+    int read(unsigned char* out, int n) {
+        z.next_out  = (char*)out;
+        z.avail_out = n;
+        while (z.avail_out > 0 && !ended) {
+            if (!raw.fill()) {
+                if (raw.error || z.total_in_lo32 > 0 || z.total_in_hi32 > 0) return -1;
+                ended = true;
+                break; }
+            z.next_in  = (char*)raw.buf + raw.pos;
+            z.avail_in = raw.available();
+            int ret = BZ2_bzDecompress(&z);
+            raw.pos = raw.size - z.avail_in;
+            if (ret == BZ_STREAM_END) {
+                BZ2_bzDecompressEnd(&z);
+                if (!raw.fill() || BZ2_bzDecompressInit(&z, 0, 0) != BZ_OK) ended = true;
+            } else if (ret != BZ_OK)
+                return -1;
+        }
+        return n - z.avail_out; }
+};
+#endif
+
+//=================================================================================================
+// PipelinedStream -- runs a decoder on its own thread, a ring of blocks ahead of the reader:
+
+class PipelinedStream : public InputStream {
+    enum { nbBlocks = 4, blockSize = 1 << 20 };
+
+    struct Block {
+        unsigned char data[blockSize];
+        int           size;          // -1 if the decoder failed.
+    };
+
+    InputStream*            source;
+    Block*                  blocks;
+    int                     head, filled; // First block not consumed, number of blocks ready.
+    int                     offset;       // Bytes of the head block already consumed.
+    bool                    finished;     // The producer has published its last block.
+    bool                    stopping;
+    std::mutex              lock;
+    std::condition_variable ready, freed;
+    std::thread             producer;
+
+    void produce() {
+        int tail = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> l(lock);
+                freed.wait(l, [this]{ return stopping || filled < nbBlocks; });
+                if (stopping) return;
+            }
+            Block& b = blocks[tail];
+            int size = 0, r = 0;
+            while (size < blockSize && (r = source->read(b.data + size, blockSize - size)) > 0)
+                size += r;
+            b.size = r < 0 ? -1 : size;
+            {
+                std::lock_guard<std::mutex> l(lock);
+                filled++;
+                if (r <= 0) finished = true;
+            }
+            ready.notify_one();
+            if (r <= 0) return;
+            tail = (tail + 1) % nbBlocks;
+        } }
+
+public:
+    PipelinedStream(InputStream* s)
+        : source(s), blocks(new Block[nbBlocks]), head(0), filled(0), offset(0)
+        , finished(false), stopping(false) {
+        producer = std::thread(&PipelinedStream::produce, this); }
+
+    ~PipelinedStream() {
+        {
+            std::lock_guard<std::mutex> l(lock);
+            stopping = true;
+        }
+        freed.notify_one();
+        producer.join();
+        delete[] blocks;
+        delete source; }
+
+    Format format() const { return source->format(); }
+
+    int read(unsigned char* out, int n) {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> l(lock);
+                ready.wait(l, [this]{ return filled > 0; });
+            }
+            // The head block is ours until it is released: the producer only writes free blocks.
+            Block& b = blocks[head];
+            if (b.size < 0) return -1;
+            if (offset < b.size) {
+                int k = b.size - offset < n ? b.size - offset : n;
+                memcpy(out, b.data + offset, k);
+                offset += k;
+                return k; }
+            {
+                std::lock_guard<std::mutex> l(lock);
+                if (finished && filled == 1) return 0;   // Keep the last block: the end is sticky.
+                filled--;
+            }
+            freed.notify_one();
+            head = (head + 1) % nbBlocks;
+            offset = 0;
+        } }
+};
+
+}
+
+//=================================================================================================
+// Format detection and opening:
+
+InputStream::Format InputStream::detect(const unsigned char* m, int n)
+{
+    if (n >= 2 && m[0] == 0x1f && m[1] == 0x8b)                                       return Gzip;
+    if (n >= 6 && memcmp(m, "\xfd" "7zXZ\0", 6) == 0)                                 return Xz;
+    if (n >= 4 && m[0] == 0x28 && m[1] == 0xb5 && m[2] == 0x2f && m[3] == 0xfd)       return Zstd;
+    if (n >= 3 && m[0] == 'B' && m[1] == 'Z' && m[2] == 'h')                          return Bzip2;
+    return Plain;
+}
+
+
+const char* InputStream::formatName(Format f)
+{
+    switch (f) {
+    case Gzip:  return "gzip";
+    case Xz:    return "xz";
+    case Zstd:  return "zstd";
+    case Bzip2: return "bzip2";
+    default:    return "plain";
+    }
+}
+
+
+bool InputStream::supported(Format f)
+{
+    switch (f) {
+#ifndef GLUCOSE_HAVE_LZMA
+    case Xz:    return false;
+#endif
+#ifndef GLUCOSE_HAVE_ZSTD
+    case Zstd:  return false;
+#endif
+#ifndef GLUCOSE_HAVE_BZIP2
+    case Bzip2: return false;
+#endif
+    default:    return true;
+    }
+}
+
+
+InputStream::Format InputStream::detect(const char* file)
+{
+    FILE* f = fopen(file, "rb");
+    if (f == NULL) return Plain;
+    unsigned char magic[6];
+    int n = (int)fread(magic, 1, sizeof(magic), f);
+    fclose(f);
+    return detect(magic, n);
+}
+
+
+InputStream* InputStream::open(const char* file, bool pipelined)
+{
+    bool  std_in = file == NULL || strcmp(file, "-") == 0;
+    FILE* f      = std_in ? stdin : fopen(file, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "ERROR! Could not open file: %s (%s)\n", file, strerror(errno));
+        return NULL; }
+
+    // The magic number is handed over to the decoder instead of being pushed back, so this works
+    // on pipes too.
+    unsigned char magic[6];
+    int n = (int)fread(magic, 1, sizeof(magic), f);
+
+    Format fmt = detect(magic, n);
+    if (!supported(fmt)) {
+        fprintf(stderr, "ERROR! %s is %s compressed, which this build does not support.\n",
+                std_in ? "<stdin>" : file, formatName(fmt));
+        if (!std_in) fclose(f);
+        return NULL; }
+
+    InputStream* s = NULL;
+    switch (fmt) {
+    case Gzip:  s = new GzipStream(f, magic, n);  break;
+#ifdef GLUCOSE_HAVE_LZMA
+    case Xz:    s = new XzStream(f, magic, n);    break;
+#endif
+#ifdef GLUCOSE_HAVE_ZSTD
+    case Zstd:  s = new ZstdStream(f, magic, n);  break;
+#endif
+#ifdef GLUCOSE_HAVE_BZIP2
+    case Bzip2: s = new Bzip2Stream(f, magic, n); break;
+#endif
+    default:    s = new PlainStream(f, magic, n); break;
+    }
+    // Plain text is not worth a thread, nor is anything on a single core.
+    if (pipelined && fmt != Plain && std::thread::hardware_concurrency() > 1)
+        return new PipelinedStream(s);
+    return s;
+}
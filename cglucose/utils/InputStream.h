@@ -0,0 +1,52 @@
+/*
+    Byte sources for the parsers, with transparent decompression.
+
+    InputStream::open() looks at the first bytes of the file (or of the standard input) and picks
+    a decoder from their magic number: gzip through zlib, xz through liblzma,
+    zstd through libzstd and bzip2 through libbz2. The last three are optional and compiled in with
+    GLUCOSE_HAVE_LZMA, GLUCOSE_HAVE_ZSTD and GLUCOSE_HAVE_BZIP2; a file in a format that was not
+    compiled in is reported instead of being parsed as garbage.
+
+    By default the decoder of a compressed file runs on a thread of its own which fills a small
+    ring of blocks ahead of the parser, so that decompression and parsing overlap on a multicore
+    machine.
+*/
+
+#ifndef Glucose_InputStream_h
+#define Glucose_InputStream_h
+
+#include <stdio.h>
+
+#include "mtl/IntTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// InputStream -- a sequence of bytes:
+
+class InputStream {
+public:
+    enum Format { Plain, Gzip, Xz, Zstd, Bzip2 };
+
+    virtual ~InputStream() {}
+
+    // Reads up to 'n' bytes into 'buf'. Returns the number of bytes read, 0 at the end of the
+    // stream and -1 on error (a corrupt or truncated compressed file).
+    virtual int read(unsigned char* buf, int n) = 0;
+
+    virtual Format format() const = 0;
+
+    // Opens 'file' ('NULL' or "-" for the standard input). Returns NULL, with a message on stderr,
+    // if the file cannot be opened or its format is not supported by this build.
+    static InputStream* open(const char* file, bool pipelined = true);
+
+    static Format      detect    (const unsigned char* magic, int n);
+    static Format      detect    (const char* file);            // Format of a file by its magic number ('Plain' if unreadable).
+    static const char* formatName(Format f);
+    static bool        supported (Format f);
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+    A minimal streaming JSON writer. Values are written as they come, objects and arrays are
+    nested with begin/end calls, and a top-level value is terminated by a new line (JSON lines).
+*/
+
+#ifndef Glucose_JsonWriter_h
+#define Glucose_JsonWriter_h
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+#include "mtl/IntTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// JsonWriter -- writes JSON values to a stream:
+
+class JsonWriter {
+    FILE*             out;
+    std::vector<bool> first;  // For each open object or array: no element written yet.
+
+    void separate(const char* key) {
+        if (!first.empty()) {
+            if (!first.back()) fputc(',', out);
+            first.back() = false;
+        }
+        if (key != NULL) { string(key); fputc(':', out); }
+    }
+
+    void string(const char* s) {
+        fputc('"', out);
+        for (; *s; s++)
+            switch (*s) {
+            case '"':  fputs("\\\"", out); break;
+            case '\\': fputs("\\\\", out); break;
+            case '\n': fputs("\\n", out); break;
+            case '\t': fputs("\\t", out); break;
+            default:
+                if ((unsigned char)*s < 0x20) fprintf(out, "\\u%04x", *s);
+                else fputc(*s, out);
+            }
+        fputc('"', out);
+    }
+
+    void close(char c) {
+        first.pop_back();
+        fputc(c, out);
+        if (first.empty()) fputc('\n', out);
+    }
+
+public:
+    JsonWriter(FILE* f) : out(f) {}
+
+    // 'key' must be given inside an object and NULL inside an array or at the top level.
+    void beginObject(const char* key = NULL) { separate(key); fputc('{', out); first.push_back(true); }
+    void endObject  ()                       { close('}'); }
+    void beginArray (const char* key = NULL) { separate(key); fputc('[', out); first.push_back(true); }
+    void endArray   ()                       { close(']'); }
+
+    void value(const char* key, const char* v) { separate(key); string(v); }
+    void null (const char* key)                { separate(key); fputs("null", out); }
+    void value(const char* key, bool v)        { separate(key); fputs(v ? "true" : "false", out); }
+    void value(const char* key, int v)         { separate(key); fprintf(out, "%d", v); }
+    void value(const char* key, int64_t v)     { separate(key); fprintf(out, "%" PRIi64, v); }
+    void value(const char* key, uint64_t v)    { separate(key); fprintf(out, "%" PRIu64, v); }
+    void value(const char* key, double v) {
+        separate(key);
+        if (isfinite(v)) fprintf(out, "%.9g", v);
+        else fputs("null", out); }
+
+    void flush() { fflush(out); }
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+    Memory accounting per data structure.
+    See MemoryAccount.h
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/MemoryAccount.h"
+
+using namespace Glucose;
+
+
+void MemoryAccount::add(const char* name, uint64_t bytes)
+{
+    size_t i = next;
+    if (i >= entries.size() || strcmp(entries[i].name, name) != 0)
+        for (i = 0; i < entries.size() && strcmp(entries[i].name, name) != 0; i++);
+    if (i == entries.size()) {
+        Entry e = { name, 0, 0, 0 };
+        entries.push_back(e);
+    }
+
+    Entry& e = entries[i];
+    if (e.collected != nbCollections + 1) e.bytes = 0, e.collected = nbCollections + 1;
+    e.bytes += bytes;
+    current += bytes;
+    next = i + 1;
+}
+
+
+void MemoryAccount::end()
+{
+    nbCollections++;
+    for (size_t i = 0; i < entries.size(); i++) {
+        Entry& e = entries[i];
+        if (e.collected != nbCollections) e.bytes = 0; // Not seen this time: the structure is gone.
+        if (e.bytes > e.peak) e.peak = e.bytes;
+    }
+    if (current > peak) peak = current;
+}
+
+
+void MemoryAccount::printStats() const
+{
+    if (nbCollections == 0) return;
+    printf("c memory (MB)           :      current         peak\n");
+    for (size_t i = 0; i < entries.size(); i++)
+        printf("c   %-20s: %12.2f %12.2f\n", entries[i].name, entries[i].bytes / 1048576.0, entries[i].peak / 1048576.0);
+    printf("c   %-20s: %12.2f %12.2f\n", "total", current / 1048576.0, peak / 1048576.0);
+}
+
+
+void MemoryAccount::writeJson(JsonWriter& json, const char* key) const
+{
+    json.beginObject(key);
+    for (size_t i = 0; i < entries.size(); i++) {
+        json.beginObject(entries[i].name);
+        json.value("bytes", entries[i].bytes);
+        json.value("peak", entries[i].peak);
+        json.endObject();
+    }
+    json.value("total", current);
+    json.value("total_peak", peak);
+    json.endObject();
+}
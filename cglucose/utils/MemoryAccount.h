@@ -0,0 +1,51 @@
+/*
+    Memory accounting per data structure.
+
+    A collection walks the structures of a solver and records the heap memory each of them holds
+    (the capacity of the vectors, not their size). The account keeps the last value and the high
+    water mark of every structure, and of their sum. Entries are identified by their name, which
+    must be a string literal (or otherwise outlive the account).
+*/
+
+#ifndef Glucose_MemoryAccount_h
+#define Glucose_MemoryAccount_h
+
+#include <vector>
+
+#include "mtl/IntTypes.h"
+#include "utils/JsonWriter.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// MemoryAccount -- bytes held by each structure, with high water marks:
+
+class MemoryAccount {
+public:
+    MemoryAccount() : next(0), current(0), peak(0), nbCollections(0) {}
+
+    void begin() { next = 0; current = 0; }       // Start a new collection.
+    void add  (const char* name, uint64_t bytes); // Record a structure (several calls with the same name are summed).
+    void end  ();                                  // Finish the collection and update the high water marks.
+
+    uint64_t total    () const { return current; }
+    uint64_t totalPeak() const { return peak; }
+
+    void printStats() const;
+    void writeJson(JsonWriter& json, const char* key) const; // An object with the bytes and peak of every structure.
+
+protected:
+    struct Entry {
+        const char* name;
+        uint64_t    bytes, peak, collected; // 'collected' is the number of the last collection seeing the entry.
+    };
+
+    std::vector<Entry> entries;
+    size_t             next;      // Entries come in the same order at each collection, try this one first.
+    uint64_t           current, peak, nbCollections;
+};
+
+//=================================================================================================
+}
+
+#endif
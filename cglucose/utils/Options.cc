@@ -89,3 +89,12 @@ void Glucose::printUsageAndExit (int argc, char** argv, bool verbose)
     exit(0);
 }
 
+
+
+void Glucose::writeOptionsJson(JsonWriter& json, const char* key)
+{
+    json.beginObject(key);
+    for (int i = 0; i < Option::getOptionList().size(); i++)
+        Option::getOptionList()[i]->writeJson(json);
+    json.endObject();
+}
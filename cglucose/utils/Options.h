@@ -28,6 +28,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "mtl/IntTypes.h"
 #include "mtl/Vec.h"
 #include "utils/ParseUtils.h"
+#include "utils/JsonWriter.h"
 
 namespace Glucose {
 
@@ -39,6 +40,7 @@ extern void parseOptions     (int& argc, char** argv, bool strict = false);
 extern void printUsageAndExit(int  argc, char** argv, bool verbose = false);
 extern void setUsageHelp     (const char* str);
 extern void setHelpPrefixStr (const char* str);
+extern void writeOptionsJson (JsonWriter& json, const char* key); // An object with the value of every option.
 
 
 //==================================================================================================
@@ -81,11 +83,13 @@ class Option
 
     virtual bool parse             (const char* str)      = 0;
     virtual void help              (bool verbose = false) = 0;
+    virtual void writeJson         (JsonWriter& json) const = 0;
 
     friend  void parseOptions      (int& argc, char** argv, bool strict);
     friend  void printUsageAndExit (int  argc, char** argv, bool verbose);
     friend  void setUsageHelp      (const char* str);
     friend  void setHelpPrefixStr  (const char* str);
+    friend  void writeOptionsJson  (JsonWriter& json, const char* key);
 };
 
 
@@ -158,6 +162,8 @@ class DoubleOption : public Option
         return true;
     }
 
+    virtual void writeJson(JsonWriter& json) const { json.value(name, value); }
+
     virtual void help (bool verbose = false){
         fprintf(stderr, "  -%-12s = %-8s %c%4.2g .. %4.2g%c (default: %g)\n", 
                 name, type_name, 
@@ -215,6 +221,8 @@ class IntOption : public Option
         return true;
     }
 
+    virtual void writeJson(JsonWriter& json) const { json.value(name, (int)value); }
+
     virtual void help (bool verbose = false){
         fprintf(stderr, "  -%-12s = %-8s [", name, type_name);
         if (range.begin == INT32_MIN)
@@ -277,6 +285,8 @@ class Int64Option : public Option
         return true;
     }
 
+    virtual void writeJson(JsonWriter& json) const { json.value(name, value); }
+
     virtual void help (bool verbose = false){
         fprintf(stderr, "  -%-12s = %-8s [", name, type_name);
         if (range.begin == INT64_MIN)
@@ -324,6 +334,8 @@ class StringOption : public Option
         return true;
     }
 
+    virtual void writeJson(JsonWriter& json) const { if (value) json.value(name, value); else json.null(name); }
+
     virtual void help (bool verbose = false){
         fprintf(stderr, "  -%-10s = %8s\n", name, type_name);
         if (verbose){
@@ -364,6 +376,8 @@ class BoolOption : public Option
         return false;
     }
 
+    virtual void writeJson(JsonWriter& json) const { json.value(name, value); }
+
     virtual void help (bool verbose = false){
 
         fprintf(stderr, "  -%s, -no-%s", name, name);
@@ -23,12 +23,56 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdarg.h>
 #include <math.h>
+#include <string>
 
 #include <zlib.h>
 
+#include "utils/InputStream.h"
+
 namespace Glucose {
 
+//-------------------------------------------------------------------------------------------------
+// Parse errors:
+//
+// A parse error prints its message and ends the process with status 3 (1 for an unreadable file),
+// unless the calling thread traps them (see 'ParseErrorTrap'): it then throws 'ParseError', which
+// is reported later. The prefetch thread must not end the process in the middle of the search, and
+// before the answer, of the previous instance.
+
+struct ParseError {
+    int         status;    // Exit status of the process.
+    FILE*       out;       // Stream of the message.
+    std::string message;   // Empty if already printed.
+    void report() const { if (!message.empty()) fputs(message.c_str(), out); fflush(out); }
+};
+
+inline int& parseErrorTraps() { static thread_local int n = 0; return n; }
+
+class ParseErrorTrap {
+public:
+    ParseErrorTrap () { parseErrorTraps()++; }
+    ~ParseErrorTrap() { parseErrorTraps()--; }
+};
+
+// A failure already reported (e.g. by InputStream::open).
+[[noreturn]] inline void parseFail(int status) {
+    if (parseErrorTraps() > 0) throw ParseError{status, stderr, std::string()};
+    exit(status); }
+
+// Prints "PARSE ERROR! " and the message on 'out', and exits with status 3.
+[[noreturn]] __attribute__((format(printf, 2, 3))) inline void parseError(FILE* out, const char* fmt, ...) {
+    char    buf[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    ParseError e{3, out, std::string("PARSE ERROR! ") + buf};
+    if (parseErrorTraps() > 0) throw e;
+    e.report();
+    exit(3); }
+
 //-------------------------------------------------------------------------------------------------
 // A simple buffered character stream class:
 
@@ -37,6 +81,7 @@ static const int buffer_size = 1048576;
 
 class StreamBuffer {
     gzFile        in;
+    InputStream*  stream;   // Used instead of 'in' when not NULL.
     unsigned char buf[buffer_size];
     int           pos;
     int           size;
@@ -44,10 +89,12 @@ class StreamBuffer {
     void assureLookahead() {
         if (pos >= size) {
             pos  = 0;
-            size = gzread(in, buf, sizeof(buf)); } }
+            size = stream != NULL ? stream->read(buf, sizeof(buf)) : gzread(in, buf, sizeof(buf));
+            if (size < 0) parseError(stderr, "Corrupt or truncated input.\n"); } }
 
 public:
-    explicit StreamBuffer(gzFile i) : in(i), pos(0), size(0) { assureLookahead(); }
+    explicit StreamBuffer(gzFile i)       : in(i),    stream(NULL), pos(0), size(0) { assureLookahead(); }
+    explicit StreamBuffer(InputStream& i) : in(NULL), stream(&i),   pos(0), size(0) { assureLookahead(); }
 
     int  operator *  () const { return (pos >= size) ? EOF : buf[pos]; }
     void operator ++ ()       { pos++; assureLookahead(); }
@@ -90,17 +137,17 @@ static double parseDouble(B& in) { // only in the form X.XXXXXe-XX
     if(*in == EOF) return 0;
     if      (*in == '-') neg = true, ++in;
     else if (*in == '+') ++in;
-    if (*in < '1' || *in > '9') printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+    if (*in < '1' || *in > '9') parseError(stdout, "Unexpected char: %c\n", *in);
 	accu = (double)(*in - '0');
 	++in;
-	if (*in != '.') printf("PARSE ERROR! Unexpected char: %c\n", *in),exit(3);
+	if (*in != '.') parseError(stdout, "Unexpected char: %c\n", *in);
 	++in; // skip dot
 	currentExponent = 0.1;
     while (*in >= '0' && *in <= '9')
         accu = accu + currentExponent * ((double)(*in - '0')),
 		currentExponent /= 10,
         ++in;
-	if (*in != 'e') printf("PARSE ERROR! Unexpected char: %c\n", *in),exit(3);
+	if (*in != 'e') parseError(stdout, "Unexpected char: %c\n", *in);
 	++in; // skip dot
 	exponent = parseInt(in); // read exponent
 	accu *= pow(10,exponent);
@@ -115,7 +162,7 @@ static int parseInt(B& in) {
     skipWhitespace(in);
     if      (*in == '-') neg = true, ++in;
     else if (*in == '+') ++in;
-    if (*in < '0' || *in > '9') fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+    if (*in < '0' || *in > '9') parseError(stderr, "Unexpected char: %c\n", *in);
     while (*in >= '0' && *in <= '9')
         val = val*10 + (*in - '0'),
         ++in;
@@ -0,0 +1,134 @@
+/*
+    Hardware performance counters attributed to the phases of a solver.
+    See PerfCounters.h
+*/
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "utils/PerfCounters.h"
+
+using namespace Glucose;
+
+static const char* phaseNames[nbSolverPhases] = {
+    "search", "propagate", "analyze", "reduceDB", "simplify", "garbage", "import", "bdd", "bddWait"
+};
+
+const char* Glucose::phaseName(int phase) { return phaseNames[phase]; }
+
+
+PerfCounters::PerfCounters() : depth(0), opened(false)
+{
+    for (int p = 0; p < nbSolverPhases; p++)
+        for (int e = 0; e < nbEvents; e++)
+            fds[p][e] = -1;
+}
+
+
+PerfCounters::~PerfCounters()
+{
+    for (int p = 0; p < nbSolverPhases; p++)
+        for (int e = 0; e < nbEvents; e++)
+            if (fds[p][e] != -1) close(fds[p][e]);
+}
+
+
+#if defined(__linux__)
+
+static int openEvent(uint32_t type, uint64_t config, int leader)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.disabled       = leader == -1;  // Members follow their leader
+    attr.inherit        = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+}
+
+
+bool PerfCounters::open()
+{
+    static const uint32_t types[nbEvents]   = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE };
+    static const uint64_t configs[nbEvents] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+    for (int p = 0; p < nbSolverPhases; p++) {
+        if ((fds[p][evCycles] = openEvent(types[evCycles], configs[evCycles], -1)) == -1) {
+            printf("c WARNING! Hardware counters not available (perf_event_open: %s), -perf is ignored\n", strerror(errno));
+            return false;
+        }
+        // A missing member only loses its own counter
+        for (int e = evCycles + 1; e < nbEvents; e++)
+            fds[p][e] = openEvent(types[e], configs[e], fds[p][evCycles]);
+    }
+    return opened = true;
+}
+
+
+void PerfCounters::start(int phase) { ioctl(fds[phase][evCycles], PERF_EVENT_IOC_ENABLE,  PERF_IOC_FLAG_GROUP); }
+void PerfCounters::stop (int phase) { ioctl(fds[phase][evCycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP); }
+
+
+int64_t PerfCounters::value(int phase, int ev) const
+{
+    uint64_t v[3]; // value, time enabled, time running
+    if (fds[phase][ev] == -1 || read(fds[phase][ev], v, sizeof(v)) != (ssize_t)sizeof(v)) return -1;
+    if (v[2] == 0) return 0;
+    return v[2] < v[1] ? (int64_t)((double)v[0] * v[1] / v[2]) : (int64_t)v[0];
+}
+
+#else
+
+bool    PerfCounters::open() { return false; }
+void    PerfCounters::start(int phase) {}
+void    PerfCounters::stop (int phase) {}
+int64_t PerfCounters::value(int phase, int ev) const { return -1; }
+
+#endif
+
+
+void PerfCounters::enter(int phase)
+{
+    if (!opened) return;
+    assert(depth < maxDepth);
+    if (depth > 0) stop(stack[depth - 1]);
+    stack[depth++] = phase;
+    start(phase);
+}
+
+
+void PerfCounters::leave()
+{
+    if (!opened) return;
+    assert(depth > 0);
+    stop(stack[--depth]);
+    if (depth > 0) start(stack[depth - 1]);
+}
+
+
+void PerfCounters::printStats() const
+{
+    if (!opened) return;
+    printf("c hardware counters     :      cycles  instructions   IPC  cache misses  branch misses\n");
+    for (int p = 0; p < nbSolverPhases; p++) {
+        int64_t v[nbEvents];
+        for (int e = 0; e < nbEvents; e++) v[e] = value(p, e);
+        if (v[evCycles] <= 0) continue;
+        printf("c   %-20s: %12" PRIi64"  %12" PRIi64"  %4.2f  %12" PRIi64"  %13" PRIi64"\n", phaseName(p),
+               v[evCycles], v[evInstructions], v[evInstructions] < 0 ? 0.0 : (double)v[evInstructions] / v[evCycles],
+               v[evCacheMisses], v[evBranchMisses]);
+    }
+}
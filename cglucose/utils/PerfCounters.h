@@ -0,0 +1,73 @@
+/*
+    Hardware performance counters (Linux perf_event_open) attributed to the phases of a solver.
+
+    Every phase owns a group of counters (cycles, instructions, cache misses, branch misses) which
+    only runs while the phase is the innermost active one: entering a phase stops the counters of
+    the enclosing phase and leaving it restarts them, so nested phases are not counted twice.
+    The counters belong to the thread which opened them and are inherited by the threads it
+    creates afterwards (the BDD thread is counted in the phase which waits for it).
+
+    Only user space is counted, which works with the default 'perf_event_paranoid' setting.
+    Entering and leaving a phase costs a system call each: this is a diagnostic mode.
+*/
+
+#ifndef Glucose_PerfCounters_h
+#define Glucose_PerfCounters_h
+
+#include "mtl/IntTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// Phases of the solver:
+
+// 'phaseSearch' is the rest of the search (decisions, restarts, learnt clauses...) and
+// 'phaseBddWait' the time spent waiting for the BDD thread inside 'phaseBdd'.
+enum SolverPhase {
+    phaseSearch, phasePropagate, phaseAnalyze, phaseReduceDB, phaseSimplify, phaseGarbage, phaseImport,
+    phaseBdd, phaseBddWait,
+    nbSolverPhases
+};
+
+const char* phaseName(int phase);
+
+//=================================================================================================
+// PerfCounters -- the counters of one thread:
+
+class PerfCounters {
+public:
+    enum { evCycles, evInstructions, evCacheMisses, evBranchMisses, nbEvents };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    // Open the counters for the calling thread. Returns false (and leaves the object unusable)
+    // if the kernel refuses them.
+    bool open();
+    bool isOpen() const { return opened; }
+
+    void enter(int phase);    // Make 'phase' the active phase.
+    void leave();             // Back to the phase active before the matching 'enter'.
+
+    // Current value of the counter 'ev' of 'phase' (scaled if the counters were multiplexed),
+    // -1 if the counter is not supported by the hardware.
+    int64_t value(int phase, int ev) const;
+
+    void printStats() const;
+
+protected:
+    enum { maxDepth = 16 };
+
+    int  fds[nbSolverPhases][nbEvents];  // fds[p][evCycles] is the leader of the group of 'p'.
+    int  stack[maxDepth];
+    int  depth;
+    bool opened;
+
+    void start(int phase);
+    void stop (int phase);
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+    Time breakdown of the phases of a solver.
+    See PhaseTimer.h
+*/
+
+#include <stdio.h>
+
+#include "utils/PhaseTimer.h"
+
+using namespace Glucose;
+
+
+// Ticks per second since the first 'enter'. Below a millisecond the measure is too coarse and a
+// nominal rate is used instead (all times are negligible then).
+double PhaseTimer::ticksPerSecond() const
+{
+    double elapsed = wallClock() - startTime;
+    if (startTime == 0 || elapsed < 1e-3) return 1e9;
+    return (now() - startTicks) / elapsed;
+}
+
+
+double PhaseTimer::total() const
+{
+    uint64_t sum = 0;
+    for (int p = 0; p < nbSolverPhases; p++) sum += ticks[p];
+    return sum / ticksPerSecond();
+}
+
+
+void PhaseTimer::printStats() const
+{
+    double rate = ticksPerSecond();
+    uint64_t sum = 0;
+    for (int p = 0; p < nbSolverPhases; p++) sum += ticks[p];
+    if (sum == 0) return;
+
+    printf("c time breakdown        :      seconds       %%        calls\n");
+    for (int p = 0; p < nbSolverPhases; p++)
+        if (calls[p] > 0)
+            printf("c   %-20s: %12.3f  %6.2f %12" PRIu64"\n", phaseName(p), ticks[p] / rate, ticks[p] * 100.0 / sum, calls[p]);
+}
+
+
+void PhaseTimer::writeJson(JsonWriter& json, const char* key) const
+{
+    double rate = ticksPerSecond();
+    json.beginObject(key);
+    for (int p = 0; p < nbSolverPhases; p++)
+        json.value(phaseName(p), ticks[p] / rate);
+    json.endObject();
+}
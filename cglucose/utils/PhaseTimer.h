@@ -0,0 +1,87 @@
+/*
+    Low overhead time breakdown of the phases of a solver (see SolverPhase in PerfCounters.h).
+
+    Time is read from the time stamp counter (or the virtual counter on ARM) and accumulated per
+    phase, exclusive of the nested phases. A timer belongs to one thread (one per solver). The
+    ticks are converted to seconds with a rate calibrated against the wall clock over the whole
+    life of the timer, so no calibration loop is needed.
+*/
+
+#ifndef Glucose_PhaseTimer_h
+#define Glucose_PhaseTimer_h
+
+#include <assert.h>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "mtl/IntTypes.h"
+#include "utils/PerfCounters.h"
+#include "utils/JsonWriter.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// PhaseTimer -- time per phase of one thread:
+
+class PhaseTimer {
+public:
+    PhaseTimer() : depth(0), last(0), startTicks(0), startTime(0) {
+        for (int p = 0; p < nbSolverPhases; p++) ticks[p] = calls[p] = 0; }
+
+    static inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t v;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    void enter(int phase) {
+        uint64_t t = now();
+        if (depth > 0) ticks[stack[depth - 1]] += t - last;
+        else if (startTime == 0) startTicks = t, startTime = wallClock();
+        assert(depth < maxDepth);
+        stack[depth++] = phase;
+        calls[phase]++;
+        last = t; }
+
+    void leave() {
+        uint64_t t = now();
+        assert(depth > 0);
+        ticks[stack[--depth]] += t - last;
+        last = t; }
+
+    uint64_t nbCalls(int phase) const { return calls[phase]; }
+    double   seconds(int phase) const { return ticks[phase] / ticksPerSecond(); }
+    double   total  () const;
+
+    void printStats() const;
+    void writeJson(JsonWriter& json, const char* key) const; // An object with the seconds of every phase.
+
+protected:
+    enum { maxDepth = 16 };
+
+    uint64_t ticks[nbSolverPhases];
+    uint64_t calls[nbSolverPhases];
+    int      stack[maxDepth];
+    int      depth;
+    uint64_t last;
+    uint64_t startTicks;  // First 'enter'.
+    double   startTime;
+
+    static double wallClock() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+    double ticksPerSecond() const;
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+    Small statistics helpers for repeated measurements: mean, sample standard deviation and
+    confidence intervals based on Student's t distribution.
+*/
+
+#ifndef Glucose_Statistics_h
+#define Glucose_Statistics_h
+
+#include <math.h>
+#include <vector>
+
+namespace Glucose {
+
+//=================================================================================================
+// Sample -- a set of measurements of the same quantity:
+
+class Sample {
+    std::vector<double> xs;
+
+public:
+    void   push  (double x)    { xs.push_back(x); }
+    void   clear ()            { xs.clear(); }
+    int    size  ()      const { return xs.size(); }
+    double operator [] (int i) const { return xs[i]; }
+
+    double mean() const {
+        if (xs.empty()) return 0;
+        double s = 0;
+        for (size_t i = 0; i < xs.size(); i++) s += xs[i];
+        return s / xs.size(); }
+
+    double variance() const {
+        if (xs.size() < 2) return 0;
+        double m = mean(), s = 0;
+        for (size_t i = 0; i < xs.size(); i++) s += (xs[i] - m) * (xs[i] - m);
+        return s / (xs.size() - 1); }
+
+    double stddev() const { return sqrt(variance()); }
+
+    // Half width of the 95% confidence interval of the mean.
+    double ci95() const {
+        if (xs.size() < 2) return 0;
+        return tQuantile95(xs.size() - 1) * stddev() / sqrt((double)xs.size()); }
+
+    // Welch's t-test of the difference of the means of two samples with possibly different
+    // variances. Returns true if the difference is significant at the 5% level.
+    static bool welch(const Sample& a, const Sample& b, double& t, double& df) {
+        t = 0; df = 0;
+        if (a.size() < 2 || b.size() < 2) return false;
+        double va = a.variance() / a.size(), vb = b.variance() / b.size();
+        if (va + vb == 0) return a.mean() != b.mean();
+        t  = (a.mean() - b.mean()) / sqrt(va + vb);
+        df = (va + vb) * (va + vb) / (va * va / (a.size() - 1) + vb * vb / (b.size() - 1));
+        return fabs(t) > tQuantile95(df); }
+
+    // Two-sided 97.5% quantile of Student's t distribution with 'df' degrees of freedom.
+    static double tQuantile95(double df) {
+        static const double t[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+        if (df < 1) return t[0];
+        if (df <= 30) return t[(int)df - 1];
+        return 1.960 + 2.4 / df; }
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -72,6 +72,21 @@ double Glucose::memUsedPeak() {
     double peak = memReadPeak() / 1024;
     return peak == 0 ? memUsed() : peak; }
 
+// Reads the limit of cgroup v2 ("max" means no limit), then the one of cgroup v1 (no limit is
+// reported as a huge number).
+double Glucose::memLimit() {
+    const char* files[] = { "/sys/fs/cgroup/memory.max", "/sys/fs/cgroup/memory/memory.limit_in_bytes" };
+    for (int i = 0; i < 2; i++) {
+        FILE* in = fopen(files[i], "rb");
+        if (in == NULL) continue;
+        unsigned long long limit;
+        int read = fscanf(in, "%llu", &limit);
+        fclose(in);
+        if (read == 1 && limit < (1ULL << 60)) return (double)limit / (1024*1024);
+        if (read == 1 || i == 0) return 0;
+    }
+    return 0; }
+
 #elif defined(__FreeBSD__)
 
 double Glucose::memUsed(void) {
@@ -79,6 +94,7 @@ double Glucose::memUsed(void) {
     getrusage(RUSAGE_SELF, &ru);
     return (double)ru.ru_maxrss / 1024; }
 double MiniSat::memUsedPeak(void) { return memUsed(); }
+double Glucose::memLimit(void) { return 0; }
 
 
 #elif defined(__APPLE__)
@@ -88,8 +104,11 @@ double Glucose::memUsed(void) {
     malloc_statistics_t t;
     malloc_zone_statistics(NULL, &t);
     return (double)t.max_size_in_use / (1024*1024); }
+double Glucose::memLimit(void) { return 0; }
 
 #else
 double Glucose::memUsed() { 
     return 0; }
+double Glucose::memLimit() { 
+    return 0; }
 #endif
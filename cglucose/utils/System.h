@@ -35,6 +35,7 @@ static inline double cpuTime(void); // CPU-time in seconds.
 static inline double realTime(void);
 extern double memUsed();            // Memory in mega bytes (returns 0 for unsupported architectures).
 extern double memUsedPeak();        // Peak-memory in mega bytes (returns 0 for unsupported architectures).
+extern double memLimit();           // Memory limit of the control group in mega bytes (returns 0 if none or unsupported).
 
 }
 